@@ -28,7 +28,8 @@ public class AchievementPlugin : ModuleRules
                 "Core",
                 "CoreUObject",
                 "Engine",
-                "DeveloperSettings"
+                "DeveloperSettings",
+                "GameplayTags"
                 // Removed PropertyEditor and ToolMenus - they're editor-only!
             }
         );
@@ -53,6 +54,7 @@ public class AchievementPlugin : ModuleRules
                 "DetailCustomizations",
                 "Settings",
                 "EditorSettingsViewer",
+                "Projects",
             });
         }
 
@@ -0,0 +1,38 @@
+#include "AchievementActiveSet.h"
+
+#include "AchievementProgressStore.h"
+#include "AchievementRegistry.h"
+
+void FAchievementActiveSet::Build(const FAchievementRegistry& registry, const FAchievementProgressStore& store)
+{
+	const int32 count = registry.Num();
+	m_isActive.Init(false, count);
+	m_positions.Init(INDEX_NONE, count);
+	m_active.Reset(count);
+
+	for (int32 registryIndex = 0; registryIndex < count; ++registryIndex)
+	{
+		const FAchievementHandle handle(registryIndex);
+		if (registry.IsLive(handle) && !store.IsUnlocked(registry.GetEntry(handle).progressIndex))
+		{
+			m_isActive[registryIndex] = true;
+			m_positions[registryIndex] = m_active.Add(registryIndex);
+		}
+	}
+}
+
+void FAchievementActiveSet::Remove(const int32 registryIndex)
+{
+	const int32 position = m_positions[registryIndex];
+	if (position == INDEX_NONE)
+		return;
+
+	const int32 lastIndex = m_active.Last();
+	m_active.RemoveAtSwap(position, 1, EAllowShrinking::No);
+	if (lastIndex != registryIndex)
+	{
+		m_positions[lastIndex] = position;
+	}
+	m_positions[registryIndex] = INDEX_NONE;
+	m_isActive[registryIndex] = false;
+}
@@ -0,0 +1,395 @@
+#include "AchievementConditions.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementRegistry.h"
+#include "AchievementStructs.h"
+
+namespace
+{
+	using EOp = FAchievementConditions::EOp;
+
+	// recursive descent over the expression, emitting postfix instructions as it goes
+	// precedence from low to high: || , && , ! , comparisons , + - , * / , unary -
+	class FConditionCompiler
+	{
+	public:
+		FConditionCompiler(const FString& expression, const FAchievementRegistry& registry,
+						   TArray<FAchievementConditions::FInstruction>& instructions, TArray<double>& constants)
+			: m_expression(expression), m_registry(registry), m_instructions(instructions), m_constants(constants)
+		{
+		}
+
+		bool Compile(FString& outError, TArray<int32>& outStats)
+		{
+			ParseOr();
+			SkipWhitespace();
+			if (m_error.IsEmpty() && m_position < m_expression.Len())
+			{
+				Fail(TEXT("unexpected character"));
+			}
+			if (m_error.IsEmpty() && m_maxDepth > FAchievementConditions::MaxStackDepth)
+			{
+				Fail(TEXT("expression is nested too deeply"));
+			}
+
+			outError = m_error;
+			outStats = MoveTemp(m_stats);
+			return m_error.IsEmpty();
+		}
+
+	private:
+		void ParseOr()
+		{
+			ParseAnd();
+			while (m_error.IsEmpty() && (Match(TEXT("||")) || MatchKeyword(TEXT("OR"))))
+			{
+				ParseAnd();
+				Emit(EOp::Or);
+			}
+		}
+
+		void ParseAnd()
+		{
+			ParseNot();
+			while (m_error.IsEmpty() && (Match(TEXT("&&")) || MatchKeyword(TEXT("AND"))))
+			{
+				ParseNot();
+				Emit(EOp::And);
+			}
+		}
+
+		void ParseNot()
+		{
+			// '!' but not the start of '!='
+			SkipWhitespace();
+			if ((Peek() == TEXT('!') && Peek(1) != TEXT('=') && Match(TEXT("!"))) || MatchKeyword(TEXT("NOT")))
+			{
+				ParseNot();
+				Emit(EOp::Not);
+				return;
+			}
+			ParseComparison();
+		}
+
+		void ParseComparison()
+		{
+			ParseSum();
+
+			// comparisons don't chain, "a < b < c" is rejected as an unexpected character
+			static const TPair<const TCHAR*, EOp> comparisons[] = {
+				{TEXT("<="), EOp::LessEqual}, {TEXT(">="), EOp::GreaterEqual}, {TEXT("=="), EOp::Equal},
+				{TEXT("!="), EOp::NotEqual}, {TEXT("<"), EOp::Less}, {TEXT(">"), EOp::Greater}
+			};
+			for (const TPair<const TCHAR*, EOp>& comparison : comparisons)
+			{
+				if (m_error.IsEmpty() && Match(comparison.Key))
+				{
+					ParseSum();
+					Emit(comparison.Value);
+					return;
+				}
+			}
+		}
+
+		void ParseSum()
+		{
+			ParseProduct();
+			while (m_error.IsEmpty())
+			{
+				if (Match(TEXT("+")))
+				{
+					ParseProduct();
+					Emit(EOp::Add);
+				}
+				else if (Match(TEXT("-")))
+				{
+					ParseProduct();
+					Emit(EOp::Subtract);
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		void ParseProduct()
+		{
+			ParseUnary();
+			while (m_error.IsEmpty())
+			{
+				if (Match(TEXT("*")))
+				{
+					ParseUnary();
+					Emit(EOp::Multiply);
+				}
+				else if (Match(TEXT("/")))
+				{
+					ParseUnary();
+					Emit(EOp::Divide);
+				}
+				else
+				{
+					return;
+				}
+			}
+		}
+
+		void ParseUnary()
+		{
+			if (Match(TEXT("-")))
+			{
+				ParseUnary();
+				Emit(EOp::Negate);
+				return;
+			}
+			ParsePrimary();
+		}
+
+		void ParsePrimary()
+		{
+			if (!m_error.IsEmpty())
+				return;
+
+			SkipWhitespace();
+			if (Match(TEXT("(")))
+			{
+				ParseOr();
+				if (m_error.IsEmpty() && !Match(TEXT(")")))
+				{
+					Fail(TEXT("missing ')'"));
+				}
+				return;
+			}
+
+			const TCHAR character = Peek();
+			if (FChar::IsDigit(character) || character == TEXT('.'))
+			{
+				const int32 start = m_position;
+				while (FChar::IsDigit(Peek()) || Peek() == TEXT('.'))
+				{
+					++m_position;
+				}
+				const double value = FCString::Atod(*m_expression.Mid(start, m_position - start));
+				Emit(EOp::PushConstant, m_constants.Add(value));
+				return;
+			}
+
+			if (FChar::IsAlpha(character) || character == TEXT('_'))
+			{
+				const int32 start = m_position;
+				while (FChar::IsAlnum(Peek()) || Peek() == TEXT('_') || Peek() == TEXT('.'))
+				{
+					++m_position;
+				}
+				const FString statId = m_expression.Mid(start, m_position - start);
+				const FAchievementStatHandle stat = m_registry.FindStatHandle(FName(*statId));
+				if (!stat.IsValid())
+				{
+					Fail(FString::Printf(TEXT("unknown stat '%s'"), *statId));
+					return;
+				}
+				m_stats.AddUnique(stat.GetIndex());
+				Emit(EOp::PushStat, stat.GetIndex());
+				return;
+			}
+
+			Fail(TEXT("expected a number, stat or '('"));
+		}
+
+		void Emit(const EOp op, const int32 operand = 0)
+		{
+			if (!m_error.IsEmpty())
+				return;
+
+			m_instructions.Add({op, operand});
+
+			// pushes grow the stack, unary ops keep it, binary ops pop one
+			if (op == EOp::PushConstant || op == EOp::PushStat)
+			{
+				m_maxDepth = FMath::Max(m_maxDepth, ++m_depth);
+			}
+			else if (op != EOp::Negate && op != EOp::Not)
+			{
+				--m_depth;
+			}
+		}
+
+		bool Match(const TCHAR* token)
+		{
+			SkipWhitespace();
+			const int32 length = FCString::Strlen(token);
+			if (FCString::Strncmp(*m_expression + m_position, token, length) != 0)
+				return false;
+
+			m_position += length;
+			return true;
+		}
+
+		// case-insensitive and only as a whole word, so "ORDERS" stays a stat name
+		bool MatchKeyword(const TCHAR* keyword)
+		{
+			SkipWhitespace();
+			const int32 length = FCString::Strlen(keyword);
+			if (FCString::Strnicmp(*m_expression + m_position, keyword, length) != 0)
+				return false;
+
+			const TCHAR next = Peek(length);
+			if (FChar::IsAlnum(next) || next == TEXT('_'))
+				return false;
+
+			m_position += length;
+			return true;
+		}
+
+		void SkipWhitespace()
+		{
+			while (FChar::IsWhitespace(Peek()))
+			{
+				++m_position;
+			}
+		}
+
+		TCHAR Peek(const int32 offset = 0) const
+		{
+			const int32 index = m_position + offset;
+			return index < m_expression.Len() ? m_expression[index] : TEXT('\0');
+		}
+
+		void Fail(const FString& message)
+		{
+			if (m_error.IsEmpty())
+			{
+				m_error = FString::Printf(TEXT("%s at column %d"), *message, m_position + 1);
+			}
+		}
+
+		const FString& m_expression;
+		const FAchievementRegistry& m_registry;
+		TArray<FAchievementConditions::FInstruction>& m_instructions;
+		TArray<double>& m_constants;
+
+		TArray<int32> m_stats;
+		FString m_error;
+		int32 m_position = 0;
+		int32 m_depth = 0;
+		int32 m_maxDepth = 0;
+	};
+}
+
+void FAchievementConditions::Build(const FAchievementRegistry& registry, const TMap<FString, FAchievementData>& achievementsData)
+{
+	Empty();
+	m_conditionByAchievement.Init(INDEX_NONE, registry.Num());
+
+	TArray<TArray<int32>> conditionsPerStat;
+	conditionsPerStat.SetNum(registry.NumStats());
+
+	for (const auto& achievementPair : achievementsData)
+	{
+		const FString& expression = achievementPair.Value.unlockCondition;
+		if (expression.IsEmpty())
+			continue;
+
+		const FAchievementHandle handle = registry.FindHandle(achievementPair.Key);
+		if (!handle.IsValid())
+			continue;
+
+		// these already unlock through something else
+		const FAchievementRegistryEntry& entry = registry.GetEntry(handle);
+		if (entry.statIndex != INDEX_NONE || entry.IsComposite() || entry.windowIndex != INDEX_NONE)
+		{
+			UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' watches a stat, has dependencies or a window, its unlock condition is ignored"), *achievementPair.Key);
+			continue;
+		}
+
+		const int32 firstInstruction = m_instructions.Num();
+		const int32 firstConstant = m_constants.Num();
+		FString error;
+		TArray<int32> readStats;
+		FConditionCompiler compiler(expression, registry, m_instructions, m_constants);
+		if (!compiler.Compile(error, readStats))
+		{
+			UE_LOG(AchievementLog, Error, TEXT("Unlock condition of achievement '%s' is invalid: %s"), *achievementPair.Key, *error);
+			m_instructions.SetNum(firstInstruction);
+			m_constants.SetNum(firstConstant);
+			continue;
+		}
+
+		const int32 conditionIndex = m_conditions.Add({handle.GetIndex(), firstInstruction, m_instructions.Num() - firstInstruction});
+		m_conditionByAchievement[handle.GetIndex()] = conditionIndex;
+		for (const int32 statIndex : readStats)
+		{
+			conditionsPerStat[statIndex].Add(conditionIndex);
+		}
+	}
+
+	// flatten into one table, same layout as the registry's stat watchers
+	m_firstConditionByStat.SetNumUninitialized(registry.NumStats() + 1);
+	for (int32 statIndex = 0; statIndex < registry.NumStats(); ++statIndex)
+	{
+		m_firstConditionByStat[statIndex] = m_conditionsByStat.Num();
+		m_conditionsByStat.Append(conditionsPerStat[statIndex]);
+	}
+	m_firstConditionByStat[registry.NumStats()] = m_conditionsByStat.Num();
+
+	if (m_conditions.Num() > 0)
+		UE_LOG(AchievementLog, Log, TEXT("Compiled %d unlock conditions into %d instructions"), m_conditions.Num(), m_instructions.Num());
+}
+
+void FAchievementConditions::Empty()
+{
+	m_conditions.Reset();
+	m_instructions.Reset();
+	m_constants.Reset();
+	m_conditionByAchievement.Reset();
+	m_conditionsByStat.Reset();
+	m_firstConditionByStat.Reset();
+}
+
+bool FAchievementConditions::Evaluate(const int32 conditionIndex, const TFunctionRef<double(int32 statIndex)> getStatValue) const
+{
+	const FCondition& condition = m_conditions[conditionIndex];
+
+	// the compiler made sure the program never goes deeper than this
+	double stack[MaxStackDepth];
+	int32 top = -1;
+
+	const FInstruction* instruction = m_instructions.GetData() + condition.firstInstruction;
+	const FInstruction* const end = instruction + condition.instructionCount;
+	for (; instruction != end; ++instruction)
+	{
+		switch (instruction->op)
+		{
+			case EOp::PushConstant: stack[++top] = m_constants[instruction->operand]; break;
+			case EOp::PushStat: stack[++top] = getStatValue(instruction->operand); break;
+			case EOp::Negate: stack[top] = -stack[top]; break;
+			case EOp::Not: stack[top] = stack[top] == 0.0 ? 1.0 : 0.0; break;
+			default:
+			{
+				// every other op is binary
+				const double right = stack[top--];
+				double& left = stack[top];
+				switch (instruction->op)
+				{
+					case EOp::Add: left = left + right; break;
+					case EOp::Subtract: left = left - right; break;
+					case EOp::Multiply: left = left * right; break;
+					// a stat that is still 0 shouldn't unlock anything through infinity
+					case EOp::Divide: left = right != 0.0 ? left / right : 0.0; break;
+					case EOp::Less: left = left < right ? 1.0 : 0.0; break;
+					case EOp::LessEqual: left = left <= right ? 1.0 : 0.0; break;
+					case EOp::Greater: left = left > right ? 1.0 : 0.0; break;
+					case EOp::GreaterEqual: left = left >= right ? 1.0 : 0.0; break;
+					case EOp::Equal: left = left == right ? 1.0 : 0.0; break;
+					case EOp::NotEqual: left = left != right ? 1.0 : 0.0; break;
+					case EOp::And: left = (left != 0.0 && right != 0.0) ? 1.0 : 0.0; break;
+					case EOp::Or: left = (left != 0.0 || right != 0.0) ? 1.0 : 0.0; break;
+					default: break;
+				}
+				break;
+			}
+		}
+	}
+	return top >= 0 && stack[top] != 0.0;
+}
@@ -0,0 +1,99 @@
+#include "AchievementCounterShards.h"
+
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	std::atomic<uint64> g_nextCounterShardsId{1};
+
+	// cached per thread so the shard lookup is free after the first increment
+	thread_local uint64 t_shardOwnerId = 0;
+	thread_local void* t_shard = nullptr;
+}
+
+FAchievementCounterShards::FAchievementCounterShards()
+	: m_instanceId(g_nextCounterShardsId.fetch_add(1, std::memory_order_relaxed))
+{}
+
+FAchievementCounterShards::~FAchievementCounterShards()
+{
+	FScopeLock lock(&m_shardsLock);
+	m_shards.Empty();
+}
+
+bool FAchievementCounterShards::Increment(const int32 counterIndex, const int64 amount)
+{
+	if (counterIndex < 0 || counterIndex >= MaxCounters)
+	{
+		return false;
+	}
+
+	FShard& shard = GetShardForCurrentThread();
+	std::atomic<FChunk*>& chunkPointer = shard.chunks[counterIndex / SlotsPerChunk];
+
+	FChunk* chunk = chunkPointer.load(std::memory_order_acquire);
+	if (!chunk)
+	{
+		// only this thread ever writes the pointer, publish it for the merging thread
+		chunk = new FChunk();
+		chunkPointer.store(chunk, std::memory_order_release);
+	}
+
+	// uncontended, the merging thread is the only other one touching this slot
+	chunk->slots[counterIndex % SlotsPerChunk].fetch_add(amount, std::memory_order_relaxed);
+	// always store, a relaxed "already dirty" check could read the flag from before Merge cleared it
+	// and leave this increment in a chunk that looks clean (the line is owned by this thread, so it's cheap)
+	chunk->bDirty.store(true, std::memory_order_release);
+	return true;
+}
+
+void FAchievementCounterShards::Merge(const TFunctionRef<void(int32 counterIndex, int64 amount)> mergeFunction)
+{
+	// sum all shards first so every counter gets reported only once
+	TMap<int32, int64> totals;
+	{
+		FScopeLock lock(&m_shardsLock);
+		for (const TUniquePtr<FShard>& shard : m_shards)
+		{
+			for (int32 chunkIndex = 0; chunkIndex < MaxChunks; ++chunkIndex)
+			{
+				FChunk* chunk = shard->chunks[chunkIndex].load(std::memory_order_acquire);
+				// clear the flag before reading, anything added while scanning marks it dirty again
+				if (!chunk || !chunk->bDirty.exchange(false, std::memory_order_acq_rel))
+					continue;
+
+				for (int32 slotIndex = 0; slotIndex < SlotsPerChunk; ++slotIndex)
+				{
+					if (chunk->slots[slotIndex].load(std::memory_order_relaxed) == 0)
+						continue;
+
+					const int64 amount = chunk->slots[slotIndex].exchange(0, std::memory_order_acq_rel);
+					if (amount != 0)
+					{
+						totals.FindOrAdd(chunkIndex * SlotsPerChunk + slotIndex) += amount;
+					}
+				}
+			}
+		}
+	}
+
+	for (const auto& total : totals)
+	{
+		mergeFunction(total.Key, total.Value);
+	}
+}
+
+FAchievementCounterShards::FShard& FAchievementCounterShards::GetShardForCurrentThread()
+{
+	if (t_shardOwnerId == m_instanceId)
+	{
+		return *static_cast<FShard*>(t_shard);
+	}
+
+	// first increment on this thread, give it its own shard
+	FScopeLock lock(&m_shardsLock);
+	FShard* shard = m_shards.Add_GetRef(MakeUnique<FShard>()).Get();
+	t_shardOwnerId = m_instanceId;
+	t_shard = shard;
+	return *shard;
+}
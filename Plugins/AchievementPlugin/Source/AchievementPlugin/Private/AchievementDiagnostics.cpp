@@ -0,0 +1,70 @@
+#include "AchievementDiagnostics.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementRegistry.h"
+#include "HAL/PlatformTime.h"
+
+void FAchievementDiagnostics::Reset(const int32 achievementCount)
+{
+	m_progressUpdates.Init(0, achievementCount);
+	m_skippedUnlocked.Init(0, achievementCount);
+	m_skippedInactive.Init(0, achievementCount);
+	m_platformWrites.Init(0, achievementCount);
+	ClearCounters();
+}
+
+void FAchievementDiagnostics::ClearCounters()
+{
+	FMemory::Memzero(m_progressUpdates.GetData(), m_progressUpdates.Num() * sizeof(uint32));
+	FMemory::Memzero(m_skippedUnlocked.GetData(), m_skippedUnlocked.Num() * sizeof(uint32));
+	FMemory::Memzero(m_skippedInactive.GetData(), m_skippedInactive.Num() * sizeof(uint32));
+	FMemory::Memzero(m_platformWrites.GetData(), m_platformWrites.Num() * sizeof(uint32));
+
+	m_totalProgressUpdates = 0;
+	m_totalSkippedUnlocked = 0;
+	m_totalSkippedInactive = 0;
+	m_totalUnlocks = 0;
+	m_totalPlatformWrites = 0;
+	m_totalPlatformStores = 0;
+
+	m_periodStartSeconds = FPlatformTime::Seconds();
+}
+
+void FAchievementDiagnostics::LogSummary(const FAchievementRegistry& registry, const bool bResetCounters)
+{
+	const double periodSeconds = FPlatformTime::Seconds() - m_periodStartSeconds;
+	UE_LOG(AchievementLog, Log, TEXT("Achievement diagnostics for the last %.1fs: %llu progress updates, %llu skipped (already unlocked), %llu rejected (inactive set), %llu unlocks, %llu platform writes in %llu stores"),
+		   periodSeconds, m_totalProgressUpdates, m_totalSkippedUnlocked, m_totalSkippedInactive, m_totalUnlocks, m_totalPlatformWrites, m_totalPlatformStores);
+
+	// only sort the achievements that actually did something
+	const int32 count = FMath::Min(registry.Num(), m_progressUpdates.Num());
+	TArray<int32> activeIndices;
+	for (int32 index = 0; index < count; ++index)
+	{
+		if (m_progressUpdates[index] != 0 || m_skippedUnlocked[index] != 0 || m_skippedInactive[index] != 0)
+		{
+			activeIndices.Add(index);
+		}
+	}
+	activeIndices.Sort([this](const int32 a, const int32 b)
+	{
+		return m_progressUpdates[a] + m_skippedUnlocked[a] + m_skippedInactive[a] > m_progressUpdates[b] + m_skippedUnlocked[b] + m_skippedInactive[b];
+	});
+
+	const int32 listedCount = FMath::Min(activeIndices.Num(), MaxListedAchievements);
+	for (int32 i = 0; i < listedCount; ++i)
+	{
+		const int32 index = activeIndices[i];
+		UE_LOG(AchievementLog, Log, TEXT("    '%s': %u updates, %u skipped, %u rejected, %u platform writes"),
+			   *registry.GetEntry(FAchievementHandle(index)).achievementId.ToString(), m_progressUpdates[index], m_skippedUnlocked[index], m_skippedInactive[index], m_platformWrites[index]);
+	}
+	if (activeIndices.Num() > listedCount)
+	{
+		UE_LOG(AchievementLog, Log, TEXT("    ... and %d more achievements"), activeIndices.Num() - listedCount);
+	}
+
+	if (bResetCounters)
+	{
+		ClearCounters();
+	}
+}
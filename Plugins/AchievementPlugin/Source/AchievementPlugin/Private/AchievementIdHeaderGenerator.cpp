@@ -0,0 +1,165 @@
+#include "AchievementIdHeaderGenerator.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementPlugin.h"
+
+#if WITH_EDITOR
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// turns an achievement ID into a valid C++ identifier
+	FString SanitizeIdentifier(const FString& achievementId)
+	{
+		FString identifier;
+		identifier.Reserve(achievementId.Len() + 3);
+		for (const TCHAR character : achievementId)
+		{
+			identifier.AppendChar(FChar::IsAlnum(character) || character == TEXT('_') ? character : TEXT('_'));
+		}
+		// identifiers cannot start with a digit
+		if (identifier.IsEmpty() || FChar::IsDigit(identifier[0]))
+		{
+			identifier.InsertAt(0, TEXT("Id_"));
+		}
+		return identifier;
+	}
+}
+
+FString FAchievementIdHeaderGenerator::GetOutputPath()
+{
+	const FString& overridePath = UAchievementPluginSettings::Get()->achievementIdHeaderPath;
+	if (!overridePath.IsEmpty())
+	{
+		return FPaths::IsRelative(overridePath) ? FPaths::Combine(FPaths::ProjectDir(), overridePath) : overridePath;
+	}
+
+	if (const TSharedPtr<IPlugin> plugin = IPluginManager::Get().FindPlugin(TEXT("AchievementPlugin")))
+	{
+		return FPaths::Combine(plugin->GetBaseDir(), TEXT("Source"), TEXT("AchievementPlugin"), TEXT("Public"), TEXT("AchievementIds.h"));
+	}
+	return FPaths::Combine(FPaths::ProjectDir(), TEXT("Source"), TEXT("AchievementIds.h"));
+}
+
+bool FAchievementIdHeaderGenerator::GenerateHeaderText(const TMap<FString, FAchievementData>& achievementsData, FString& outHeaderText, FString& outError)
+{
+	// sort by ID so the output only changes when the achievements do
+	TArray<FString> achievementIds;
+	achievementsData.GetKeys(achievementIds);
+	achievementIds.Sort();
+
+	TMap<FString, FString> usedIdentifiers;
+	TMap<int32, FString> usedLinkIDs;
+
+	FString enumEntries;
+	for (const FString& achievementId : achievementIds)
+	{
+		const int32 linkID = achievementsData[achievementId].GetLinkID();
+		if (linkID < 0 || linkID > MAX_uint16)
+		{
+			outError = FString::Printf(TEXT("Achievement '%s' has LinkID '%d' which does not fit in EAchievementId"), *achievementId, linkID);
+			return false;
+		}
+		if (const FString* otherId = usedLinkIDs.Find(linkID))
+		{
+			outError = FString::Printf(TEXT("Achievements '%s' and '%s' share LinkID '%d'"), **otherId, *achievementId, linkID);
+			return false;
+		}
+		usedLinkIDs.Add(linkID, achievementId);
+
+		const FString identifier = SanitizeIdentifier(achievementId);
+		if (const FString* otherId = usedIdentifiers.Find(identifier))
+		{
+			outError = FString::Printf(TEXT("Achievements '%s' and '%s' both turn into identifier '%s'"), **otherId, *achievementId, *identifier);
+			return false;
+		}
+		usedIdentifiers.Add(identifier, achievementId);
+
+		enumEntries += FString::Printf(TEXT("\t%s = %d,\n"), *identifier, linkID);
+	}
+
+	outHeaderText = FString::Printf(TEXT(
+		"// This file is generated from the Achievement Plugin settings, do not edit it by hand!\n"
+		"// Regenerate it with the \"Generate Achievement ID Header\" button or -run=GenerateAchievementIds\n"
+		"#pragma once\n"
+		"\n"
+		"#include \"AchievementPlugin.h\"\n"
+		"\n"
+		"// the value of every ID is the achievement's LinkID\n"
+		"enum class EAchievementId : uint16\n"
+		"{\n"
+		"%s"
+		"};\n"
+		"\n"
+		"namespace AchievementIds\n"
+		"{\n"
+		"\t// amount of achievements when this header was generated\n"
+		"\tconstexpr int32 Num = %d;\n"
+		"\n"
+		"\t// resolves without any hashing, the LinkID indexes straight into the registry\n"
+		"\tinline FAchievementHandle GetHandle(const EAchievementId id)\n"
+		"\t{\n"
+		"\t\treturn UAchievementManagerSubSystem::Get()->GetRegistry().FindHandleByLinkID(static_cast<int32>(id));\n"
+		"\t}\n"
+		"\n"
+		"\tinline bool IncreaseProgress(const EAchievementId id, const float increase, const EAchievementUpdateMode mode = EAchievementUpdateMode::Immediate)\n"
+		"\t{\n"
+		"\t\treturn UAchievementManagerSubSystem::Get()->IncreaseAchievementProgress(GetHandle(id), increase, mode);\n"
+		"\t}\n"
+		"}\n"),
+		*enumEntries, achievementIds.Num());
+	return true;
+}
+
+bool FAchievementIdHeaderGenerator::WriteHeader(const FString& outputPath)
+{
+	FString headerText;
+	FString error;
+	if (!GenerateHeaderText(UAchievementPluginSettings::Get()->achievementsData, headerText, error))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Could not generate the achievement ID header: %s"), *error);
+		return false;
+	}
+
+	FString existingText;
+	if (FFileHelper::LoadFileToString(existingText, *outputPath) && existingText == headerText)
+	{
+		UE_LOG(AchievementLog, Log, TEXT("Achievement ID header '%s' is already up to date"), *outputPath);
+		return true;
+	}
+
+	if (!FFileHelper::SaveStringToFile(headerText, *outputPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Failed to write the achievement ID header to '%s'"), *outputPath);
+		return false;
+	}
+
+	UE_LOG(AchievementLog, Log, TEXT("Generated achievement ID header at '%s'"), *outputPath);
+	return true;
+}
+#endif
+
+UGenerateAchievementIdsCommandlet::UGenerateAchievementIdsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UGenerateAchievementIdsCommandlet::Main(const FString& params)
+{
+#if WITH_EDITOR
+	FString outputPath;
+	if (!FParse::Value(*params, TEXT("output="), outputPath))
+	{
+		outputPath = FAchievementIdHeaderGenerator::GetOutputPath();
+	}
+	return FAchievementIdHeaderGenerator::WriteHeader(outputPath) ? 0 : 1;
+#else
+	UE_LOG(AchievementLog, Error, TEXT("The achievement ID header can only be generated in editor builds"));
+	return 1;
+#endif
+}
@@ -0,0 +1,119 @@
+#include "AchievementListenerRegistry.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementRegistry.h"
+
+void FAchievementListenerRegistry::Rebind(const FAchievementRegistry& registry)
+{
+	TArray<TArray<FListener>> oldListeners = MoveTemp(m_listenersByAchievement);
+	m_listenersByAchievement.Reset();
+	m_listenersByAchievement.SetNum(registry.Num());
+	m_achievementIndexBySubscription.Reset();
+
+	for (TArray<FListener>& listeners : oldListeners)
+	{
+		for (FListener& listener : listeners)
+		{
+			const FAchievementHandle handle = registry.FindHandle(listener.achievementId);
+			if (!handle.IsValid())
+			{
+				UE_LOG(AchievementLog, Warning, TEXT("Dropped a listener for achievement '%s', it no longer exists"), *listener.achievementId.ToString());
+				continue;
+			}
+			m_achievementIndexBySubscription.Add(listener.subscriptionId, handle.GetIndex());
+			m_listenersByAchievement[handle.GetIndex()].Add(MoveTemp(listener));
+		}
+	}
+}
+
+void FAchievementListenerRegistry::Empty()
+{
+	m_listenersByAchievement.Empty();
+	m_achievementIndexBySubscription.Empty();
+}
+
+int32 FAchievementListenerRegistry::Subscribe(const FAchievementHandle handle, const FName achievementId, const FOnAchievementProgressUpdated& listener)
+{
+	const int32 subscriptionId = m_nextSubscriptionId++;
+
+	FListener& newListener = m_listenersByAchievement[handle.GetIndex()].AddDefaulted_GetRef();
+	newListener.subscriptionId = subscriptionId;
+	newListener.achievementId = achievementId;
+	newListener.delegate = listener;
+
+	m_achievementIndexBySubscription.Add(subscriptionId, handle.GetIndex());
+	return subscriptionId;
+}
+
+bool FAchievementListenerRegistry::Unsubscribe(const int32 subscriptionId)
+{
+	int32 registryIndex = INDEX_NONE;
+	if (!m_achievementIndexBySubscription.RemoveAndCopyValue(subscriptionId, registryIndex))
+		return false;
+
+	TArray<FListener>& listeners = m_listenersByAchievement[registryIndex];
+	const int32 listenerIndex = listeners.IndexOfByPredicate([subscriptionId](const FListener& listener)
+	{
+		return listener.subscriptionId == subscriptionId;
+	});
+	if (listenerIndex != INDEX_NONE)
+	{
+		// while notifying the list is only unbound, Notify removes it afterwards
+		if (m_bNotifying)
+			listeners[listenerIndex].delegate.Unbind();
+		else
+			listeners.RemoveAt(listenerIndex);
+	}
+	return true;
+}
+
+int32 FAchievementListenerRegistry::UnsubscribeAll(const UObject* listenerObject)
+{
+	int32 removedCount = 0;
+	for (TArray<FListener>& listeners : m_listenersByAchievement)
+	{
+		for (FListener& listener : listeners)
+		{
+			if (listener.delegate.IsBoundToObject(listenerObject))
+			{
+				m_achievementIndexBySubscription.Remove(listener.subscriptionId);
+				listener.delegate.Unbind();
+				++removedCount;
+			}
+		}
+		if (!m_bNotifying)
+		{
+			listeners.RemoveAll([](const FListener& listener)
+			{
+				return !listener.delegate.IsBound();
+			});
+		}
+	}
+	return removedCount;
+}
+
+void FAchievementListenerRegistry::Notify(const FAchievementHandle handle, const FAchievementProgress& progress)
+{
+	const int32 registryIndex = handle.GetIndex();
+
+	// by index and on a copy, listeners are allowed to (un)subscribe while being called
+	{
+		TGuardValue<bool> notifyingGuard(m_bNotifying, true);
+		const int32 listenerCount = m_listenersByAchievement[registryIndex].Num();
+		for (int32 index = 0; index < listenerCount; ++index)
+		{
+			const FOnAchievementProgressUpdated delegate = m_listenersByAchievement[registryIndex][index].delegate;
+			delegate.ExecuteIfBound(handle, progress);
+		}
+	}
+
+	// drops listeners that unsubscribed while being called and those whose object got destroyed
+	m_listenersByAchievement[registryIndex].RemoveAll([this](const FListener& listener)
+	{
+		if (listener.delegate.IsBound())
+			return false;
+
+		m_achievementIndexBySubscription.Remove(listener.subscriptionId);
+		return true;
+	});
+}
@@ -0,0 +1,259 @@
+#include "AchievementLocalUserProgress.h"
+
+#include "AchievementRegistry.h"
+
+void FAchievementLocalUserProgress::Build(const FAchievementRegistry& registry)
+{
+	m_rowSize = 0;
+	m_columnByIndex.SetNumUninitialized(registry.Num());
+	m_linkIDs.SetNumUninitialized(registry.Num());
+	for (int32 registryIndex = 0; registryIndex < registry.Num(); ++registryIndex)
+	{
+		const FAchievementHandle handle(registryIndex);
+		m_columnByIndex[registryIndex] = registry.IsLive(handle) ? m_rowSize++ : INDEX_NONE;
+		m_linkIDs[registryIndex] = registry.GetEntry(handle).linkID;
+	}
+
+	const int32 count = m_localUserIndices.Num() * m_rowSize;
+	m_progress.Init(0.f, count);
+	m_unlocked.Init(false, count);
+	m_unlockedTicks.Init(FAchievementProgress::NeverUnlockedTicks, count);
+	m_inactiveProgress.Reset();
+	m_inactiveProgress.SetNum(m_localUserIndices.Num());
+}
+
+void FAchievementLocalUserProgress::Empty()
+{
+	m_localUserIndices.Empty();
+	m_rowSize = 0;
+	m_columnByIndex.Empty();
+	m_linkIDs.Empty();
+	m_progress.Empty();
+	m_unlocked.Empty();
+	m_unlockedTicks.Empty();
+	m_inactiveProgress.Empty();
+}
+
+int32 FAchievementLocalUserProgress::AddUser(const int32 localUserIndex)
+{
+	const int32 row = m_localUserIndices.Add(localUserIndex);
+
+	m_progress.AddZeroed(m_rowSize);
+	m_unlocked.Add(false, m_rowSize);
+	m_unlockedTicks.Reserve(m_unlockedTicks.Num() + m_rowSize);
+	for (int32 index = 0; index < m_rowSize; ++index)
+	{
+		m_unlockedTicks.Add(FAchievementProgress::NeverUnlockedTicks);
+	}
+	m_inactiveProgress.AddDefaulted();
+	return row;
+}
+
+bool FAchievementLocalUserProgress::RemoveUser(const int32 localUserIndex)
+{
+	const int32 row = FindUser(localUserIndex);
+	if (row == INDEX_NONE)
+		return false;
+
+	RemoveRow(row);
+	return true;
+}
+
+void FAchievementLocalUserProgress::RemoveRow(const int32 row)
+{
+	// move the last row into the gap instead of shifting every row after it
+	const int32 lastRow = m_localUserIndices.Num() - 1;
+	if (row != lastRow)
+	{
+		const int32 offset = row * m_rowSize;
+		const int32 lastOffset = lastRow * m_rowSize;
+		FMemory::Memcpy(m_progress.GetData() + offset, m_progress.GetData() + lastOffset, m_rowSize * sizeof(float));
+		FMemory::Memcpy(m_unlockedTicks.GetData() + offset, m_unlockedTicks.GetData() + lastOffset, m_rowSize * sizeof(int64));
+		for (int32 index = 0; index < m_rowSize; ++index)
+		{
+			m_unlocked[offset + index] = static_cast<bool>(m_unlocked[lastOffset + index]);
+		}
+	}
+
+	m_localUserIndices.RemoveAtSwap(row);
+	m_inactiveProgress.RemoveAtSwap(row);
+	const int32 count = m_localUserIndices.Num() * m_rowSize;
+	m_progress.SetNum(count);
+	m_unlocked.SetNumUninitialized(count);
+	m_unlockedTicks.SetNum(count);
+}
+
+FAchievementProgress FAchievementLocalUserProgress::GetProgressStruct(const int32 row, const int32 registryIndex) const
+{
+	if (!IsLive(registryIndex))
+	{
+		const FAchievementProgressStore& inactiveProgress = m_inactiveProgress[row];
+		const int32 storeIndex = inactiveProgress.FindIndex(m_linkIDs[registryIndex]);
+		return storeIndex != INDEX_NONE ? inactiveProgress.GetProgressStruct(storeIndex) : FAchievementProgress();
+	}
+
+	const int32 offset = GetOffset(row, registryIndex);
+
+	FAchievementProgress progress;
+	progress.progress = m_progress[offset];
+	progress.bIsAchievementUnlocked = m_unlocked[offset];
+	progress.unlockedTicks = m_unlockedTicks[offset];
+	return progress;
+}
+
+void FAchievementLocalUserProgress::IncreaseProgress(const int32 row, const FAchievementRegistry& registry, const int32 registryIndex, const float increase, TArray<int32>& outUnlocked)
+{
+	if (IsUnlocked(row, registryIndex))
+		return;
+
+	const float newProgress = GetProgress(row, registryIndex) + increase;
+	if (newProgress >= registry.GetEntry(FAchievementHandle(registryIndex)).progressGoal)
+	{
+		UnlockWithDependents(row, registry, registryIndex, outUnlocked);
+	}
+	else
+	{
+		SetProgress(row, registryIndex, newProgress);
+	}
+}
+
+void FAchievementLocalUserProgress::RefreshComposites(const int32 row, const FAchievementRegistry& registry, TArray<int32>& outUnlocked)
+{
+	// in dependency order, so every composite sees the final state of what it depends on
+	for (const int32 compositeIndex : registry.GetCompositeOrder())
+	{
+		if (!IsLive(compositeIndex) || IsUnlocked(row, compositeIndex))
+			continue;
+
+		const FAchievementHandle handle(compositeIndex);
+		int32 satisfiedCount = 0;
+		for (const int32 dependencyIndex : registry.GetDependencies(handle))
+		{
+			if (IsDependencyUnlocked(row, dependencyIndex))
+			{
+				++satisfiedCount;
+			}
+		}
+
+		if (satisfiedCount >= registry.GetEntry(handle).requiredDependencies)
+		{
+			UnlockWithDependents(row, registry, compositeIndex, outUnlocked);
+		}
+		else
+		{
+			SetProgress(row, compositeIndex, satisfiedCount);
+		}
+	}
+}
+
+void FAchievementLocalUserProgress::UnlockWithDependents(const int32 row, const FAchievementRegistry& registry, const int32 registryIndex, TArray<int32>& outUnlocked)
+{
+	SetProgress(row, registryIndex, registry.GetEntry(FAchievementHandle(registryIndex)).progressGoal);
+	Unlock(row, registryIndex, FDateTime::UtcNow().GetTicks());
+	outUnlocked.Add(registryIndex);
+
+	// same as the primary user, only the composites downstream of this one
+	for (const int32 dependentIndex : registry.GetDependents(FAchievementHandle(registryIndex)))
+	{
+		if (!IsLive(dependentIndex) || IsUnlocked(row, dependentIndex))
+			continue;
+
+		const float satisfiedCount = GetProgress(row, dependentIndex) + 1.f;
+		if (satisfiedCount >= registry.GetEntry(FAchievementHandle(dependentIndex)).requiredDependencies)
+		{
+			UnlockWithDependents(row, registry, dependentIndex, outUnlocked);
+		}
+		else
+		{
+			SetProgress(row, dependentIndex, satisfiedCount);
+		}
+	}
+}
+
+bool FAchievementLocalUserProgress::IsDependencyUnlocked(const int32 row, const int32 registryIndex) const
+{
+	if (IsLive(registryIndex))
+		return IsUnlocked(row, registryIndex);
+
+	const FAchievementProgressStore& inactiveProgress = m_inactiveProgress[row];
+	const int32 storeIndex = inactiveProgress.FindIndex(m_linkIDs[registryIndex]);
+	return storeIndex != INDEX_NONE && inactiveProgress.IsUnlocked(storeIndex);
+}
+
+void FAchievementLocalUserProgress::Export(const int32 row, FAchievementProgressStore& outStore) const
+{
+	outStore.Empty();
+	for (int32 registryIndex = 0; registryIndex < m_columnByIndex.Num(); ++registryIndex)
+	{
+		if (!IsLive(registryIndex))
+			continue;
+
+		const int32 offset = GetOffset(row, registryIndex);
+		const int32 storeIndex = outStore.FindOrAdd(m_linkIDs[registryIndex]);
+		outStore.SetProgress(storeIndex, m_progress[offset]);
+		if (m_unlocked[offset])
+		{
+			outStore.Unlock(storeIndex, m_unlockedTicks[offset]);
+		}
+	}
+	// the inactive sets' LinkIDs never have a column, so this only adds to the store
+	outStore.Merge(m_inactiveProgress[row]);
+}
+
+void FAchievementLocalUserProgress::Import(const int32 row, const FAchievementRegistry& registry, const FAchievementProgressStore& store)
+{
+	ResetRow(row);
+	Merge(row, registry, store);
+}
+
+void FAchievementLocalUserProgress::Merge(const int32 row, const FAchievementRegistry& registry, const FAchievementProgressStore& store)
+{
+	for (int32 registryIndex = 0; registryIndex < m_columnByIndex.Num(); ++registryIndex)
+	{
+		const int32 storeIndex = store.FindIndex(registry.GetEntry(FAchievementHandle(registryIndex)).linkID);
+		if (storeIndex == INDEX_NONE)
+			continue;
+
+		if (!IsLive(registryIndex))
+		{
+			MergeInactive(row, store, storeIndex);
+			continue;
+		}
+
+		const int32 offset = GetOffset(row, registryIndex);
+		m_progress[offset] = FMath::Max(m_progress[offset], store.GetProgress(storeIndex));
+		// the earlier unlock wins, that is when it really happened
+		if (store.IsUnlocked(storeIndex) && (!m_unlocked[offset] || store.GetUnlockedTicks(storeIndex) < m_unlockedTicks[offset]))
+		{
+			m_unlocked[offset] = true;
+			m_unlockedTicks[offset] = store.GetUnlockedTicks(storeIndex);
+		}
+	}
+}
+
+void FAchievementLocalUserProgress::MergeInactive(const int32 row, const FAchievementProgressStore& store, const int32 storeIndex)
+{
+	// most users never touched most of a past season, those don't need an entry at all
+	if (store.GetProgress(storeIndex) == 0.f && !store.IsUnlocked(storeIndex))
+		return;
+
+	FAchievementProgressStore& inactiveProgress = m_inactiveProgress[row];
+	const int32 index = inactiveProgress.FindOrAdd(store.GetLinkID(storeIndex));
+	inactiveProgress.SetProgress(index, FMath::Max(inactiveProgress.GetProgress(index), store.GetProgress(storeIndex)));
+	if (store.IsUnlocked(storeIndex) && (!inactiveProgress.IsUnlocked(index) || store.GetUnlockedTicks(storeIndex) < inactiveProgress.GetUnlockedTicks(index)))
+	{
+		inactiveProgress.Unlock(index, store.GetUnlockedTicks(storeIndex));
+	}
+}
+
+void FAchievementLocalUserProgress::ResetRow(const int32 row)
+{
+	const int32 offset = row * m_rowSize;
+	FMemory::Memzero(m_progress.GetData() + offset, m_rowSize * sizeof(float));
+	m_unlocked.SetRange(offset, m_rowSize, false);
+	for (int32 index = 0; index < m_rowSize; ++index)
+	{
+		m_unlockedTicks[offset + index] = FAchievementProgress::NeverUnlockedTicks;
+	}
+	m_inactiveProgress[row].Empty();
+}
@@ -1,4 +1,10 @@
 #include "AchievementLogCategory.h"
 
 DEFINE_LOG_CATEGORY(AchievementLog);
-DEFINE_LOG_CATEGORY(AchievementPlatformLog)
\ No newline at end of file
+DEFINE_LOG_CATEGORY(AchievementPlatformLog)
+
+TAutoConsoleVariable<bool> CVarAchievementVerboseLogging(
+	TEXT("Achievements.VerboseLogging"),
+	false,
+	TEXT("Logs every achievement progress update and platform write. Use Achievements.DumpDiagnostics for an aggregated summary instead"),
+	ECVF_Default);
@@ -45,13 +45,55 @@ void UAchievementPlatformsClass::ShutdownPlatform()
 	}
 }
 
-bool UAchievementPlatformsClass::SetPlatformAchievementProgress(const FAchievementPlatformData& platformData, const int32 progress, const bool unlocked)
+bool UAchievementPlatformsClass::SetPlatformAchievementProgress(const FAchievementPlatformData& platformData, const int32 progress, const bool unlocked, const bool bStoreImmediately)
 {
 	switch (selectedPlatform)
 	{
 		case STEAM:
 		{
-			return SteamAchievementsClass::SetSteamAchievementProgress(platformData, progress, unlocked);
+			return SteamAchievementsClass::SetSteamAchievementProgress(platformData, progress, unlocked, bStoreImmediately);
+		}
+
+		default:break;
+	}
+	return true;
+}
+
+bool UAchievementPlatformsClass::SetPlatformStat(const FAchievementStatPlatformData& platformData, const EAchievementStatType type, const double value, const bool bStoreImmediately)
+{
+	switch (selectedPlatform)
+	{
+		case STEAM:
+		{
+			return SteamAchievementsClass::SetSteamStat(platformData, type, value, bStoreImmediately);
+		}
+
+		default:break;
+	}
+	return true;
+}
+
+bool UAchievementPlatformsClass::UpdatePlatformAverageRateStat(const FAchievementStatPlatformData& platformData, const double count, const double seconds, const bool bStoreImmediately)
+{
+	switch (selectedPlatform)
+	{
+		case STEAM:
+		{
+			return SteamAchievementsClass::UpdateSteamAverageRateStat(platformData, count, seconds, bStoreImmediately);
+		}
+
+		default:break;
+	}
+	return true;
+}
+
+bool UAchievementPlatformsClass::StorePlatformProgress()
+{
+	switch (selectedPlatform)
+	{
+		case STEAM:
+		{
+			return SteamAchievementsClass::StoreSteamStats();
 		}
 
 		default:break;
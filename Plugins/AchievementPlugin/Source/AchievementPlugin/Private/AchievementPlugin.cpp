@@ -4,15 +4,52 @@
 
 #if WITH_EDITOR
 #include "ISettingsModule.h"
+#include "AchievementIdHeaderGenerator.h"
 #endif
 
 #include "AchievementLogCategory.h"
 #include "USaveSystem.h"
 #include "AchievementPlatforms.h"
+#include "Misc/App.h"
 
 
 #define LOCTEXT_NAMESPACE "FAchievementPluginModule"
 
+static TAutoConsoleVariable<float> CVarAchievementDiagnosticsInterval(
+	TEXT("Achievements.DiagnosticsInterval"),
+	0.f,
+	TEXT("Seconds between aggregated achievement diagnostics summaries in the log, 0 disables them"),
+	ECVF_Default);
+
+static FAutoConsoleCommand CAchievementBenchmarkConditions(
+	TEXT("Achievements.BenchmarkConditions"),
+	TEXT("Evaluates every achievement unlock condition against the current stats, optionally followed by the iteration count (default 10000)"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& args)
+	{
+		const int32 iterations = args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*args[0])) : 10000;
+		if (GEngine)
+		{
+			if (const auto* manager = GEngine->GetEngineSubsystem<UAchievementManagerSubSystem>())
+			{
+				manager->BenchmarkConditions(iterations);
+			}
+		}
+	}));
+
+static FAutoConsoleCommand CAchievementDumpDiagnostics(
+	TEXT("Achievements.DumpDiagnostics"),
+	TEXT("Logs the achievement progress and platform counters gathered since the last summary"),
+	FConsoleCommandDelegate::CreateLambda([]()
+	{
+		if (GEngine)
+		{
+			if (auto* manager = GEngine->GetEngineSubsystem<UAchievementManagerSubSystem>())
+			{
+				manager->LogDiagnosticsSummary();
+			}
+		}
+	}));
+
 void FAchievementPluginModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -114,7 +151,7 @@ void UAchievementPluginSettings::PostEditChangeProperty(FPropertyChangedEvent& p
 		{
 			// From any class that has access to the engine
 			const auto* manager = UAchievementManagerSubSystem::Get();
-			manager->GetSaveManager()->SaveProgressAsync(manager->achievementsProgress);
+			manager->GetSaveManager()->SaveProgressAsync(manager->GetProgressStore(), manager->GetStatStore());
 
 			// Reset so it can be clicked again
 			bForceSaveAchievements = false;
@@ -128,15 +165,28 @@ void UAchievementPluginSettings::PostEditChangeProperty(FPropertyChangedEvent& p
 		{
 			// From any class that has access to the engine
 			auto* manager = UAchievementManagerSubSystem::Get();
-			manager->achievementsProgress = manager->GetSaveManager()->LoadProgress();
+			manager->GetSaveManager()->LoadProgress(manager->GetProgressStore(), manager->GetStatStore());
 
 			manager->CleanupAchievements();
+			manager->InitializeAchievements();
 
 			// Reset so it can be clicked again
 			bForceLoadAchievementProgress = false;
 		}
 	}
 
+	// generate the compile-time achievement ID header button
+	else if (changedPropertyName == GET_MEMBER_NAME_CHECKED(UAchievementPluginSettings, bGenerateAchievementIdHeader))
+	{
+		if (bGenerateAchievementIdHeader) // only when checked
+		{
+			FAchievementIdHeaderGenerator::WriteHeader(FAchievementIdHeaderGenerator::GetOutputPath());
+
+			// Reset so it can be clicked again
+			bGenerateAchievementIdHeader = false;
+		}
+	}
+
 	// force download Steam achievements button
 	else if (changedPropertyName == GET_MEMBER_NAME_CHECKED(UAchievementPluginSettings, bForceDownloadSteamAchievements))
 	{
@@ -157,9 +207,10 @@ void UAchievementPluginSettings::PostEditChangeProperty(FPropertyChangedEvent& p
 		if (progressStuff) // only when checked
 		{
 			auto* manager = UAchievementManagerSubSystem::Get();
-			for (auto& progress : manager->achievementsProgress)
+			auto& progressStore = manager->GetProgressStore();
+			for (int32 index = 0; index < progressStore.Num(); ++index)
 			{
-				progress.Value.progress = FMath::RandRange(1, 100);
+				progressStore.SetProgress(index, FMath::RandRange(1, 100));
 			}
 
 			// Reset so it can be clicked again
@@ -200,7 +251,7 @@ void UAchievementPluginSettings::PostEditChangeProperty(FPropertyChangedEvent& p
 
 					// create the empty Achievement Progress as well
 					auto* manager = UAchievementManagerSubSystem::Get();
-					manager->achievementsProgress.Add(linkID, FAchievementProgress());
+					manager->GetProgressStore().FindOrAdd(linkID);
 					UE_LOG(AchievementLog, Log, TEXT("Created a new achievement with Link ID '%d'"), linkID);
 
 					AttemptSave();
@@ -215,6 +266,14 @@ void UAchievementPluginSettings::PostEditChangeProperty(FPropertyChangedEvent& p
 		UAchievementPlatformsClass::CreateSteamAppIdFile(m_steamAppID);
 	}
 
+	// any change inside the achievements or stats (including renames and goals) invalidates the runtime registry
+	if (propertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAchievementPluginSettings, achievementsData) ||
+		propertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAchievementPluginSettings, statsData) ||
+		propertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(UAchievementPluginSettings, achievementSets))
+	{
+		UAchievementManagerSubSystem::Get()->RebuildRegistry();
+	}
+
 	Super::PostEditChangeProperty(propertyChangedEvent);
 }
 
@@ -229,17 +288,16 @@ void UAchievementPluginSettings::AttemptSave()
 
 void UAchievementPluginSettings::UpdateRuntimeStats()
 {
-	const auto progressData = UAchievementManagerSubSystem::Get()->achievementsProgress;
+	const auto& progressStore = UAchievementManagerSubSystem::Get()->GetProgressStore();
 	// look for the progress that has the same LinkID
 	for (auto& chiev : achievementsData)
 	{
-		if (const auto* progress = progressData.Find(chiev.Value.GetLinkID()))
+		const int32 progressIndex = progressStore.FindIndex(chiev.Value.GetLinkID());
+		if (progressIndex != INDEX_NONE)
 		{
 			// set the currentProgress
-			chiev.Value.UpdateProgressEditorOnly(*progress);
-
+			chiev.Value.UpdateProgressEditorOnly(progressStore.GetProgressStruct(progressIndex));
 		}
-
 	}
 }
 #endif
@@ -286,28 +344,65 @@ void UAchievementManagerSubSystem::Initialize(FSubsystemCollectionBase& collecti
 
 	// load the progress if any existed
 	const UAchievementPluginSettings* settings = UAchievementPluginSettings::Get();
-	achievementsProgress = m_saveManager->LoadProgress();
+	// ClampMin only applies in the editor, a hand-edited ini can hold anything
+	m_progressQueue = MakeUnique<FAchievementProgressQueue>(static_cast<uint32>(FMath::Clamp(settings->progressQueueCapacity, 64, 1 << 20)));
+	m_saveManager->LoadProgress(m_progressStore, m_statStore);
 
-	// then make sure all achievements have a progress one as well
-	InitializeAchievements();
+	// build the lookup table used by handles, this also makes sure all achievements have a progress one as well
+	RebuildRegistry();
 
 	// make sure to remove any deleted achievements
 	if (UAchievementPluginSettings::Get()->bCleanupAchievements)
 		CleanupAchievements();
+
+	m_bInitialized = true;
 }
 
 void UAchievementManagerSubSystem::Deinitialize()
 {
+	// apply anything that was still queued or counted so it ends up in the save
+	DrainProgressQueue();
+	MergeCounters();
+	ApplyAccumulatedProgress();
+	SyncStatProgress();
+	EvaluateDirtyConditions();
+	FlushPlatformProgress();
+	m_bInitialized = false;
+
 	// Make sure to save the current achievementsData before exiting (using the sync, not Async version)
 	if (m_saveManager)
 	{
 
 		// then attempt to save
-		const bool bSavedCorrectly = m_saveManager->SaveProgress(achievementsProgress);
+		const bool bSavedCorrectly = m_saveManager->SaveProgress(m_progressStore, m_statStore);
 		if (!bSavedCorrectly)
 		{
 			UE_LOG(AchievementLog, Error, TEXT("Achievements could not be saved properly!"));
 		}
+
+		// split-screen users that never left have their own slots
+		for (int32 row = 0; row < m_localUsers.NumUsers(); ++row)
+		{
+			SaveLocalUserProgress(m_localUsers.GetLocalUserIndex(row));
+		}
+
+		// same for server players that are still connected, synchronous since the subsystem is going away
+		// players whose save never finished loading are skipped, saving them would overwrite the slot
+		TArray<FUniqueNetIdRepl> dirtyPlayers = MoveTemp(m_serverSaveQueue);
+		m_serverPlayers.CollectDirtyPlayers(dirtyPlayers);
+		FAchievementProgressStore playerProgress;
+		for (const FUniqueNetIdRepl& playerId : dirtyPlayers)
+		{
+			if (m_serverPlayers.ExportPlayer(playerId, playerProgress))
+			{
+				m_saveManager->SavePlayerProgress(playerProgress, playerId);
+			}
+		}
+		if (m_pendingServerPlayerSaves.Num() > 0)
+		{
+			UE_LOG(AchievementLog, Warning, TEXT("%d server players left before their save finished loading, their progress of this session is not saved"),
+				   m_pendingServerPlayerSaves.Num());
+		}
 	}
 	else
 	{
@@ -318,90 +413,1305 @@ void UAchievementManagerSubSystem::Deinitialize()
 	Super::Deinitialize();
 }
 
-void UAchievementManagerSubSystem::InitializeAchievements()
+void UAchievementManagerSubSystem::BuildLiveAchievements()
 {
 	const UAchievementPluginSettings* settings = UAchievementPluginSettings::Get();
-	// if there are as many achievements as there are progress for them, return
-	if (settings->achievementsData.Num() == achievementsProgress.Num())
-		return;
+	m_setSchedule.Build(settings->achievementSets, FDateTime::UtcNow());
+	TBitArray<> isLive;
+	const int32 inactiveCount = m_setSchedule.BuildLiveBits(m_registry, isLive);
+	m_registry.SetLiveAchievements(isLive, settings->achievementsData);
+	m_tagBindings.Build(m_registry, m_conditions, settings->achievementsData);
+
+	// the other users' rows only have columns for live achievements, lay them out again and keep the progress by LinkID
+	// Export only needs what the rows remembered, so this works right after the registry itself was rebuilt too
+	TArray<FAchievementProgressStore> localUserProgress;
+	localUserProgress.SetNum(m_localUsers.NumUsers());
+	for (int32 row = 0; row < m_localUsers.NumUsers(); ++row)
+	{
+		m_localUsers.Export(row, localUserProgress[row]);
+	}
+	m_localUsers.Build(m_registry);
+	for (int32 row = 0; row < m_localUsers.NumUsers(); ++row)
+	{
+		m_localUsers.Import(row, m_registry, localUserProgress[row]);
+		RefreshLocalUserComposites(row);
+	}
+	m_serverPlayers.Build(m_registry);
 
-	// Add missing achievements progress
-	const auto& data = settings->achievementsData;
-	for (const auto& achievementPair : data)
+	if (inactiveCount > 0)
+		UE_LOG(AchievementLog, Log, TEXT("%d achievement sets are active, %d achievements of inactive sets are not evaluated"), m_setSchedule.NumActiveSets(), inactiveCount);
+}
+
+void UAchievementManagerSubSystem::InitializeAchievements()
+{
+	// Add missing achievements progress and stat values and point the registry at them
+	m_registry.BindProgress(m_progressStore);
+	m_registry.BindStats(m_statStore);
+	// progress could have been loaded or reset, everything below only looks at what is still locked
+	m_activeSet.Build(m_registry, m_progressStore);
+	m_bSnapshotDirty = true;
+
+	// stats could have been loaded (or achievements added) without the watching achievements knowing about it
+	RefreshStatAchievements();
+	// same for composites, those go last since stats can unlock their dependencies
+	RefreshCompositeAchievements();
+	// windowed progress from a save is meaningless, it matches the (empty) windows again
+	AdvanceWindows();
+
+	// and conditions over stats that were loaded could hold already
+	for (int32 conditionIndex = 0; conditionIndex < m_conditions.Num(); ++conditionIndex)
 	{
-		const auto id = achievementPair.Value.GetLinkID();
-		// if the id doesn't exist in the achievements progress yet
-		if (!achievementsProgress.Contains(id))
+		if (!m_hasDirtyCondition[conditionIndex])
 		{
-			// create an empty achievement with that id
-			achievementsProgress.Add(id, FAchievementProgress());
-			UE_LOG(AchievementLog, Log, TEXT("Created a new achievement Progress for '%s'"), *achievementPair.Key);
+			m_hasDirtyCondition[conditionIndex] = true;
+			m_dirtyConditions.Add(conditionIndex);
 		}
 	}
+	EvaluateDirtyConditions();
 }
 
 void UAchievementManagerSubSystem::CleanupAchievements()
 {
 	// Remove any progress entries that don't exist in settings anymore
-	UAchievementPluginSettings* settings = UAchievementPluginSettings::Get();
+	// achievements of inactive sets are still in the settings, so their progress is kept for when the set returns
+	const UAchievementPluginSettings* settings = UAchievementPluginSettings::Get();
 
-	const int startingCount = achievementsProgress.Num();
-	TArray<int32> linkIDs = TArray<int32>();
+	TSet<int32> linkIDs = TSet<int32>();
+	linkIDs.Reserve(settings->achievementsData.Num());
 	for (const auto& chievs : settings->achievementsData)
 	{
 		linkIDs.Add(chievs.Value.GetLinkID());
 	}
 
-	// used the UE5 documentation for this one https://dev.epicgames.com/documentation/en-us/unreal-engine/map-containers-in-unreal-engine#iterate
-
-	// Iterate with iterator so we can safely remove during iteration
-	for (auto it = achievementsProgress.CreateIterator(); it; ++it)
+	const int32 removedAchievements = m_progressStore.RemoveAll([&linkIDs](const int32 linkID)
 	{
-		if (!linkIDs.Contains(it.Key()))
-		{
-			it.RemoveCurrent();
-		}
-	}
+		return !linkIDs.Contains(linkID);
+	});
+	const int32 removedStats = m_statStore.RemoveAll([this](const FName statId)
+	{
+		return !m_registry.FindStatHandle(statId).IsValid();
+	});
+
+	// removing compacts the stores, so the registry has to point at the new indices
+	m_registry.BindProgress(m_progressStore);
+	m_registry.BindStats(m_statStore);
+
+	if (removedStats != 0)
+		UE_LOG(AchievementLog, Log, TEXT("Cleanup finished, deleted %d stats."), removedStats)
 
 	// log how many achievements were removed if any were
-	const int removedAchievements = startingCount - achievementsProgress.Num();
 	if (removedAchievements != 0)
 		UE_LOG(AchievementLog, Log, TEXT("Cleanup finished, deleted achievement progress for %d achievements."), removedAchievements)
 }
 
-bool UAchievementManagerSubSystem::IncreaseAchievementProgress(const FString& achievementId, const float increase)
+void UAchievementManagerSubSystem::RebuildRegistry()
+{
+	// queued, counted and accumulated progress as well as platform writes point at the old registry order, apply them first
+	DrainProgressQueue();
+	MergeCounters();
+	ApplyAccumulatedProgress();
+	SyncStatProgress();
+	EvaluateDirtyConditions();
+	FlushPlatformProgress();
+	DispatchAchievementEvents();
+
+	// every achievement gets built, inactive sets only clear their live bits so handles never change with the schedule
+	// conditions and listeners are resolved before that, they have to find the achievements of inactive sets too
+	const UAchievementPluginSettings* settings = UAchievementPluginSettings::Get();
+	m_registry.Build(settings->achievementsData, settings->statsData);
+	m_conditions.Build(m_registry, settings->achievementsData);
+	m_hasDirtyCondition.Init(false, m_conditions.Num());
+	m_dirtyConditions.Reset();
+	m_listeners.Rebind(m_registry);
+	BuildLiveAchievements();
+
+	m_hasPendingPlatformWrite.Init(false, m_registry.Num());
+	m_hasAccumulatedDelta.Init(false, m_registry.Num());
+	m_accumulatedDeltas.SetNumZeroed(m_registry.Num());
+
+	m_hasPendingStatWrite.Init(false, m_registry.NumStats());
+	m_pendingRateCounts.Init(0.0, m_registry.NumStats());
+	m_pendingRateSeconds.Init(0.0, m_registry.NumStats());
+	m_hasChanged.Init(false, m_registry.Num());
+	m_changedHandles.Reset();
+	m_unlockedHandles.Reset();
+	m_windowedCounters.Build(m_registry);
+
+	m_statThresholdCursors.Init(0, m_registry.NumStats());
+	m_hasStaleStatProgress.Init(false, m_registry.NumStats());
+	m_staleStatProgress.Reset();
+
+	// sized first, stat-driven achievements can unlock (and queue platform writes) while binding
+	InitializeAchievements();
+
+	// the counters are per registry index as well
+	m_diagnostics.Reset(m_registry.Num());
+}
+
+TMap<int32, FAchievementProgress> UAchievementManagerSubSystem::GetAchievementsProgress() const
+{
+	return m_progressStore.ToMap();
+}
+
+FAchievementHandle UAchievementManagerSubSystem::GetAchievementHandle(const FName achievementId) const
+{
+	const FAchievementHandle handle = m_registry.FindHandle(achievementId);
+	if (!handle.IsValid())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement with the name '%s' cannot be found or its set isn't active!"), *achievementId.ToString());
+	}
+	return handle;
+}
+
+FName UAchievementManagerSubSystem::GetAchievementId(const FAchievementHandle handle) const
+{
+	return m_registry.IsValidHandle(handle) ? m_registry.GetEntry(handle).achievementId : NAME_None;
+}
+
+FAchievementProgress UAchievementManagerSubSystem::GetAchievementProgress(const FAchievementHandle handle) const
+{
+	if (!m_registry.IsValidHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid achievement handle '%d'"), handle.GetIndex());
+		return FAchievementProgress();
+	}
+	return m_progressStore.GetProgressStruct(m_registry.GetEntry(handle).progressIndex);
+}
+
+bool UAchievementManagerSubSystem::IncreaseAchievementProgress(const FName achievementId, const float increase, const EAchievementUpdateMode mode)
+{
+	const FAchievementHandle handle = GetAchievementHandle(achievementId);
+	if (!handle.IsValid())
+	{
+		return false;
+	}
+	return IncreaseAchievementProgress(handle, increase, mode);
+}
+
+bool UAchievementManagerSubSystem::IncreaseAchievementProgress(const FAchievementHandle handle, const float increase, const EAchievementUpdateMode mode)
 {
-	const auto linkId = UAchievementPluginSettings::Get()->GetLinkIDByAchievementID(achievementId);
-	if (auto* achievementProgress = achievementsProgress.Find(linkId))
+	if (mode == EAchievementUpdateMode::Accumulate)
 	{
-		// if it was already unlocked, return
-		if (achievementProgress->bIsAchievementUnlocked)
+		if (!m_registry.IsValidHandle(handle))
+		{
+			UE_LOG(AchievementLog, Error, TEXT("Invalid achievement handle '%d'"), handle.GetIndex());
+			return false;
+		}
+
+		// out of season isn't the same as unlocked, the caller is told (CanChangeProgress logs why)
+		const int32 index = handle.GetIndex();
+		if (!m_registry.IsLive(handle))
+		{
+			m_diagnostics.RecordSkippedInactive(index);
+			return CanChangeProgress(handle);
+		}
+
+		// nothing left to sum for unlocked achievements
+		if (!m_activeSet.IsActive(index))
 		{
-			UE_LOG(AchievementLog, Log, TEXT("Achievement '%s' was already unlocked, skipping."), *achievementId);
+			m_diagnostics.RecordSkippedUnlocked(index);
 			return true;
 		}
 
-		// if goal has been reached, unlock it
-		const auto& achievement = UAchievementPluginSettings::Get()->achievementsData.Find(achievementId);
-		const auto goal = achievement->progressGoal;
+		// only sum it for now, ApplyAccumulatedProgress does the rest at the end of the frame
+		if (!m_hasAccumulatedDelta[index])
+		{
+			m_hasAccumulatedDelta[index] = true;
+			m_accumulatedIndices.Add(index);
+		}
+		m_accumulatedDeltas[index] += increase;
+		return true;
+	}
+
+	if (!ApplyProgressIncrease(handle, increase))
+	{
+		return false;
+	}
+	FlushPlatformProgress();
+	return true;
+}
+
+int32 UAchievementManagerSubSystem::IncreaseAchievementProgressBatch(const TArrayView<const FAchievementProgressChange> changes)
+{
+	// apply everything locally first, the platform only gets one flush at the end
+	int32 appliedCount = 0;
+	for (const FAchievementProgressChange& change : changes)
+	{
+		if (ApplyProgressIncrease(ResolveProgressChange(change), change.change))
+		{
+			++appliedCount;
+		}
+	}
+	FlushPlatformProgress();
+
+	ACHIEVEMENT_LOG_VERBOSE(AchievementLog, Log, TEXT("Applied %d of %d batched achievement progress changes"), appliedCount, changes.Num());
+	return appliedCount;
+}
+
+void UAchievementManagerSubSystem::FlushPlatformProgress()
+{
+	if (m_pendingPlatformWrites.Num() == 0 && m_pendingStatWrites.Num() == 0)
+		return;
 
-		if (achievementProgress->progress + increase >= goal)
+	// every stat is written once, the achievements watching it don't upload their own progress
+	for (const int32 statIndex : m_pendingStatWrites)
+	{
+		const FAchievementStatRegistryEntry& stat = m_registry.GetStatEntry(FAchievementStatHandle(statIndex));
+		if (stat.type == EAchievementStatType::AverageRate)
 		{
-			achievementProgress->progress = goal;
-			achievementProgress->bIsAchievementUnlocked = true;
-			achievementProgress->unlockedTime = FDateTime::Now().ToString();
+			UAchievementPlatformsClass::UpdatePlatformAverageRateStat(stat.platformData, m_pendingRateCounts[statIndex], m_pendingRateSeconds[statIndex], false);
+			m_pendingRateCounts[statIndex] = 0.0;
+			m_pendingRateSeconds[statIndex] = 0.0;
 		}
 		else
 		{
-			achievementProgress->progress += increase;
+			UAchievementPlatformsClass::SetPlatformStat(stat.platformData, stat.type, m_statStore.GetValue(stat.valueIndex), false);
+		}
+		m_hasPendingStatWrite[statIndex] = false;
+	}
+	m_pendingStatWrites.Reset();
+
+	for (const int32 registryIndex : m_pendingPlatformWrites)
+	{
+		const FAchievementRegistryEntry& achievement = m_registry.GetEntry(FAchievementHandle(registryIndex));
+		const int32 index = achievement.progressIndex;
+		UAchievementPlatformsClass::SetPlatformAchievementProgress(achievement.platformData, m_progressStore.GetProgress(index), m_progressStore.IsUnlocked(index), false);
+		m_hasPendingPlatformWrite[registryIndex] = false;
+		m_diagnostics.RecordPlatformWrite(registryIndex);
+	}
+	m_pendingPlatformWrites.Reset();
+
+	UAchievementPlatformsClass::StorePlatformProgress();
+	m_diagnostics.RecordPlatformStore();
+	MarkSaveDirty();
+}
+
+int32 UAchievementManagerSubSystem::CommitTransaction(const TConstArrayView<FAchievementProgressChange> progressChanges, const TConstArrayView<FAchievementTransactionStatChange> statChanges)
+{
+	// all or nothing, the registry could have changed since the changes were added
+	for (const FAchievementTransactionStatChange& change : statChanges)
+	{
+		if (!CanChangeStat(change.handle))
+			return 0;
+	}
+	for (const FAchievementProgressChange& change : progressChanges)
+	{
+		if (!CanChangeProgress(change.handle))
+			return 0;
+	}
+
+	int32 appliedCount = 0;
+	for (const FAchievementTransactionStatChange& change : statChanges)
+	{
+		const double currentValue = m_statStore.GetValue(m_registry.GetStatEntry(change.handle).valueIndex);
+		if (SetStat(change.handle, change.bIsSet ? change.value : currentValue + change.value))
+		{
+			++appliedCount;
+		}
+	}
+	for (const FAchievementProgressChange& change : progressChanges)
+	{
+		if (ApplyProgressIncrease(change.handle, change.change))
+		{
+			++appliedCount;
 		}
-		UAchievementPlatformsClass::SetPlatformAchievementProgress(achievement->platformData, achievementProgress->progress, achievementProgress->bIsAchievementUnlocked);
+	}
+
+	// conditions over the changed stats unlock in this commit as well, not in a second pass next tick
+	SyncStatProgress();
+	EvaluateDirtyConditions();
+	// one upload and one store for the whole transaction
+	FlushPlatformProgress();
+
+	ACHIEVEMENT_LOG_VERBOSE(AchievementLog, Log, TEXT("Committed achievement transaction with %d progress and %d stat changes"), progressChanges.Num(), statChanges.Num());
+	return appliedCount;
+}
+
+bool UAchievementManagerSubSystem::CanChangeProgress(const FAchievementHandle handle) const
+{
+	if (!CanChangeOwnProgress(handle))
+		return false;
+
+	if (!m_registry.IsLive(handle))
+	{
+		const FAchievementRegistryEntry& achievement = m_registry.GetEntry(handle);
+		UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' is part of set '%s' which isn't active"), *achievement.achievementId.ToString(), *achievement.achievementSet.ToString());
+		return false;
+	}
+	return true;
+}
+
+bool UAchievementManagerSubSystem::CanChangeOwnProgress(const FAchievementHandle handle) const
+{
+	if (!m_registry.IsValidHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid achievement handle '%d'"), handle.GetIndex());
+		return false;
+	}
+
+	const FAchievementRegistryEntry& achievement = m_registry.GetEntry(handle);
+	// the progress of these comes from their stat
+	if (achievement.statIndex != INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' watches stat '%s', change the stat instead of its progress"),
+			   *achievement.achievementId.ToString(), *m_registry.GetStatEntry(FAchievementStatHandle(achievement.statIndex)).statId.ToString());
+		return false;
+	}
+	// and these from their dependencies
+	if (achievement.IsComposite())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' unlocks through its dependencies, its progress cannot be changed"), *achievement.achievementId.ToString());
+		return false;
+	}
+	// and these from their unlock condition
+	if (m_conditions.FindCondition(handle.GetIndex()) != INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' unlocks through its unlock condition, change the stats it reads instead"), *achievement.achievementId.ToString());
+		return false;
+	}
+	return true;
+}
+
+bool UAchievementManagerSubSystem::CanChangeStat(const FAchievementStatHandle handle) const
+{
+	if (!m_registry.IsValidStatHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid stat handle '%d'"), handle.GetIndex());
+		return false;
+	}
+	if (m_registry.GetStatEntry(handle).type == EAchievementStatType::AverageRate)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Stat '%s' is an average rate, use AddAverageRateSample instead"), *m_registry.GetStatEntry(handle).statId.ToString());
+		return false;
+	}
+	return true;
+}
+
+bool UAchievementManagerSubSystem::ApplyProgressIncrease(const FAchievementHandle handle, const float increase)
+{
+	if (!m_registry.IsValidHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid achievement handle '%d'"), handle.GetIndex());
+		return false;
+	}
+
+	// out of season isn't the same as unlocked, the caller is told (CanChangeProgress logs why)
+	if (!m_registry.IsLive(handle))
+	{
+		m_diagnostics.RecordSkippedInactive(handle.GetIndex());
+		return CanChangeProgress(handle);
+	}
 
-		UE_LOG(AchievementLog, Log, TEXT("Increased progress for '%s' to '%f'"), *achievementId, achievementProgress->progress);
+	// late in a save most calls are for unlocked achievements, reject those before touching anything else
+	if (!m_activeSet.IsActive(handle.GetIndex()))
+	{
+		m_diagnostics.RecordSkippedUnlocked(handle.GetIndex());
 		return true;
 	}
-	UE_LOG(AchievementLog, Error, TEXT("Could not find achievement progress for the '%s'"), *achievementId);
-	return false;
+
+	if (!CanChangeProgress(handle))
+		return false;
+
+	const FAchievementRegistryEntry& achievement = m_registry.GetEntry(handle);
+	const int32 index = achievement.progressIndex;
+
+	m_diagnostics.RecordProgressUpdate(handle.GetIndex());
+
+	// windowed achievements only count what is still inside their window
+	const bool bIsWindowed = achievement.windowIndex != INDEX_NONE;
+	const float newProgress = bIsWindowed
+		? m_windowedCounters.Add(achievement.windowIndex, increase, FApp::GetCurrentTime())
+		: m_progressStore.GetProgress(index) + increase;
+
+	// if goal has been reached, unlock it
+	const auto goal = achievement.progressGoal;
+	if (newProgress >= goal)
+	{
+		UnlockAchievement(handle.GetIndex());
+	}
+	else
+	{
+		m_progressStore.SetProgress(index, newProgress);
+		MarkProgressChanged(handle.GetIndex());
+
+		// queue the platform write, FlushPlatformProgress sends it (windowed progress is too short-lived to upload)
+		if (!bIsWindowed)
+			QueuePlatformWrite(handle.GetIndex());
+	}
+
+	ACHIEVEMENT_LOG_VERBOSE(AchievementLog, Log, TEXT("Increased progress for '%s' to '%f'"), *achievement.achievementId.ToString(), m_progressStore.GetProgress(index));
+	return true;
+}
+
+void UAchievementManagerSubSystem::UnlockAchievement(const int32 registryIndex)
+{
+	const FAchievementRegistryEntry& achievement = m_registry.GetEntry(FAchievementHandle(registryIndex));
+	const int32 index = achievement.progressIndex;
+
+	m_progressStore.SetProgress(index, achievement.progressGoal);
+	// UTC ticks, no timezone conversion or string formatting on the hot path
+	m_progressStore.Unlock(index, FDateTime::UtcNow().GetTicks());
+	m_activeSet.Remove(registryIndex);
+	m_diagnostics.RecordUnlock();
+	MarkUnlocked(registryIndex);
+	QueuePlatformWrite(registryIndex);
+
+	// unlocks only happen once per achievement, so these are always worth a line
+	UE_LOG(AchievementLog, Log, TEXT("Unlocked achievement '%s'"), *achievement.achievementId.ToString());
+
+	// only the composites downstream of this one have to be looked at, the recursion depth is bounded by the DAG's depth
+	for (const int32 dependentIndex : m_registry.GetDependents(FAchievementHandle(registryIndex)))
+	{
+		if (!m_activeSet.IsActive(dependentIndex))
+			continue;
+
+		const FAchievementRegistryEntry& dependent = m_registry.GetEntry(FAchievementHandle(dependentIndex));
+
+		// the progress of a composite is its amount of unlocked dependencies
+		const float satisfiedCount = m_progressStore.GetProgress(dependent.progressIndex) + 1.f;
+		if (satisfiedCount >= dependent.requiredDependencies)
+		{
+			UnlockAchievement(dependentIndex);
+		}
+		else
+		{
+			m_progressStore.SetProgress(dependent.progressIndex, satisfiedCount);
+			QueuePlatformWrite(dependentIndex);
+			MarkProgressChanged(dependentIndex);
+		}
+	}
+}
+
+void UAchievementManagerSubSystem::RefreshCompositeAchievements()
+{
+	// in dependency order, so every composite sees the final state of what it depends on
+	for (const int32 compositeIndex : m_registry.GetCompositeOrder())
+	{
+		if (!m_activeSet.IsActive(compositeIndex))
+			continue;
+
+		const FAchievementHandle handle(compositeIndex);
+		const int32 index = m_registry.GetEntry(handle).progressIndex;
+		int32 satisfiedCount = 0;
+		// by the stored progress, a locked dependency of an inactive set isn't active either but still counts as locked
+		for (const int32 dependencyIndex : m_registry.GetDependencies(handle))
+		{
+			if (m_progressStore.IsUnlocked(m_registry.GetEntry(FAchievementHandle(dependencyIndex)).progressIndex))
+			{
+				++satisfiedCount;
+			}
+		}
+
+		if (satisfiedCount >= m_registry.GetEntry(handle).requiredDependencies)
+		{
+			UnlockAchievement(compositeIndex);
+		}
+		else if (m_progressStore.GetProgress(index) != satisfiedCount)
+		{
+			m_progressStore.SetProgress(index, satisfiedCount);
+			MarkProgressChanged(compositeIndex);
+		}
+	}
+}
+
+int32 UAchievementManagerSubSystem::ReportGameplayEvent(const FGameplayTag eventTag, const float magnitude)
+{
+	if (!eventTag.IsValid())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("ReportGameplayEvent called without a valid tag"));
+		return 0;
+	}
+
+	// only what the event actually counted towards, unlocked achievements are skipped by their bit
+	int32 appliedCount = 0;
+	for (const int32 registryIndex : m_tagBindings.Find(eventTag))
+	{
+		if (!m_activeSet.IsActive(registryIndex))
+		{
+			m_diagnostics.RecordSkippedUnlocked(registryIndex);
+			continue;
+		}
+		if (ApplyProgressIncrease(FAchievementHandle(registryIndex), magnitude))
+		{
+			++appliedCount;
+		}
+	}
+
+	if (appliedCount > 0)
+		FlushPlatformProgress();
+	return appliedCount;
+}
+
+void UAchievementManagerSubSystem::ResetAchievementScope(const EAchievementScope scope)
+{
+	// only bumps the scope's generation, AdvanceWindows picks the cleared windows up at the end of the frame
+	m_windowedCounters.ResetScope(scope);
+	ACHIEVEMENT_LOG_VERBOSE(AchievementLog, Log, TEXT("Reset achievement scope %d"), static_cast<int32>(scope));
+}
+
+void UAchievementManagerSubSystem::AdvanceWindows()
+{
+	const double currentTime = FApp::GetCurrentTime();
+	const TConstArrayView<int32> windowedAchievements = m_registry.GetWindowedAchievements();
+	for (int32 windowIndex = 0; windowIndex < windowedAchievements.Num(); ++windowIndex)
+	{
+		const int32 registryIndex = windowedAchievements[windowIndex];
+		if (!m_activeSet.IsActive(registryIndex))
+			continue;
+
+		const int32 index = m_registry.GetEntry(FAchievementHandle(registryIndex)).progressIndex;
+
+		const float windowTotal = m_windowedCounters.Advance(windowIndex, currentTime);
+		if (m_progressStore.GetProgress(index) != windowTotal)
+		{
+			m_progressStore.SetProgress(index, windowTotal);
+			MarkProgressChanged(registryIndex);
+		}
+	}
+}
+
+bool UAchievementManagerSubSystem::AddLocalUser(const int32 localUserIndex)
+{
+	if (localUserIndex == PrimaryLocalUser || m_localUsers.FindUser(localUserIndex) != INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Warning, TEXT("Local user %d already has achievement progress"), localUserIndex);
+		return false;
+	}
+
+	// the only load for this user, every update afterwards stays in memory
+	FAchievementProgressStore loadedProgress;
+	GetSaveManager()->LoadLocalUserProgress(loadedProgress, localUserIndex);
+
+	const int32 row = m_localUsers.AddUser(localUserIndex);
+	m_localUsers.Import(row, m_registry, loadedProgress);
+	RefreshLocalUserComposites(row);
+	return true;
+}
+
+bool UAchievementManagerSubSystem::RemoveLocalUser(const int32 localUserIndex, const bool bSave)
+{
+	if (m_localUsers.FindUser(localUserIndex) == INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Local user %d was never added"), localUserIndex);
+		return false;
+	}
+
+	if (bSave)
+		SaveLocalUserProgress(localUserIndex);
+
+	// unlocks that were not broadcast yet still belong to the user, the events only carry its index
+	return m_localUsers.RemoveUser(localUserIndex);
+}
+
+bool UAchievementManagerSubSystem::IsLocalUserAdded(const int32 localUserIndex) const
+{
+	return localUserIndex == PrimaryLocalUser || m_localUsers.FindUser(localUserIndex) != INDEX_NONE;
+}
+
+bool UAchievementManagerSubSystem::SaveLocalUserProgress(const int32 localUserIndex) const
+{
+	const int32 row = m_localUsers.FindUser(localUserIndex);
+	if (row == INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Local user %d was never added"), localUserIndex);
+		return false;
+	}
+
+	FAchievementProgressStore progress;
+	m_localUsers.Export(row, progress);
+	return GetSaveManager()->SaveLocalUserProgress(progress, localUserIndex);
+}
+
+bool UAchievementManagerSubSystem::IncreaseAchievementProgressForUser(const int32 localUserIndex, const FAchievementHandle handle, const float increase)
+{
+	if (localUserIndex == PrimaryLocalUser)
+		return IncreaseAchievementProgress(handle, increase);
+
+	const int32 row = m_localUsers.FindUser(localUserIndex);
+	if (row == INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Local user %d was never added, call AddLocalUser first"), localUserIndex);
+		return false;
+	}
+	if (!CanChangeSecondaryUserProgress(handle))
+		return false;
+
+	TArray<int32> unlockedIndices;
+	m_localUsers.IncreaseProgress(row, m_registry, handle.GetIndex(), increase, unlockedIndices);
+	QueueLocalUserUnlocks(row, unlockedIndices);
+	return true;
+}
+
+FAchievementProgress UAchievementManagerSubSystem::GetAchievementProgressForUser(const int32 localUserIndex, const FAchievementHandle handle) const
+{
+	if (localUserIndex == PrimaryLocalUser)
+		return GetAchievementProgress(handle);
+
+	const int32 row = m_localUsers.FindUser(localUserIndex);
+	if (row == INDEX_NONE || !m_registry.IsValidHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("No progress for achievement handle '%d' of local user %d"), handle.GetIndex(), localUserIndex);
+		return FAchievementProgress();
+	}
+	return m_localUsers.GetProgressStruct(row, handle.GetIndex());
+}
+
+bool UAchievementManagerSubSystem::CanChangeSecondaryUserProgress(const FAchievementHandle handle, const bool bCheckLive) const
+{
+	if (!(bCheckLive ? CanChangeProgress(handle) : CanChangeOwnProgress(handle)))
+		return false;
+
+	const FAchievementRegistryEntry& achievement = m_registry.GetEntry(handle);
+	// windows only exist once, for the primary user
+	if (achievement.windowIndex != INDEX_NONE)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' is windowed, it can only be changed for the primary user"), *achievement.achievementId.ToString());
+		return false;
+	}
+	return true;
+}
+
+bool UAchievementManagerSubSystem::AddServerPlayer(const FUniqueNetIdRepl& playerId)
+{
+	if (!playerId.IsValid() || !m_serverPlayers.AddPlayer(playerId))
+	{
+		UE_LOG(AchievementLog, Warning, TEXT("Player '%s' is invalid or already has achievement progress"), *playerId.ToString());
+		return false;
+	}
+
+	// the row can be used right away, the save gets merged in once it's there
+	// it isn't saved before that, the slot would lose everything that is still loading
+	GetSaveManager()->LoadPlayerProgressAsync(playerId, FOnPlayerProgressLoaded::CreateWeakLambda(this,
+		[this](const FUniqueNetIdRepl& loadedPlayerId, const FAchievementProgressStore& progress)
+		{
+			FAchievementProgressStore pendingProgress;
+			const bool bHasPendingSave = m_pendingServerPlayerSaves.RemoveAndCopyValue(loadedPlayerId, pendingProgress);
+			if (m_serverPlayers.MergePlayer(loadedPlayerId, progress))
+			{
+				// left and came back while loading, what the earlier visit did isn't lost either
+				if (bHasPendingSave)
+					m_serverPlayers.MergePlayer(loadedPlayerId, pendingProgress);
+				return;
+			}
+
+			// the player left before the load finished, save the combination now
+			if (bHasPendingSave)
+			{
+				pendingProgress.Merge(progress);
+				GetSaveManager()->SavePlayerProgressAsync(pendingProgress, loadedPlayerId);
+			}
+		}));
+	return true;
+}
+
+bool UAchievementManagerSubSystem::RemoveServerPlayer(const FUniqueNetIdRepl& playerId, const bool bSave)
+{
+	FAchievementProgressStore progress;
+	if (!m_serverPlayers.ExportPlayer(playerId, progress))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Player '%s' has no achievement progress"), *playerId.ToString());
+		return false;
+	}
+
+	if (bSave)
+	{
+		if (m_serverPlayers.IsPlayerLoaded(playerId))
+		{
+			GetSaveManager()->SavePlayerProgressAsync(progress, playerId);
+		}
+		else
+		{
+			// the save is still loading, writing now would overwrite it, the load callback saves both together
+			m_pendingServerPlayerSaves.FindOrAdd(playerId).Merge(progress);
+		}
+	}
+
+	return m_serverPlayers.RemovePlayer(playerId);
+}
+
+bool UAchievementManagerSubSystem::IncreaseServerPlayerProgress(const FUniqueNetIdRepl& playerId, const FAchievementHandle handle, const float increase)
+{
+	// the registry's live bits change on the game thread, the shards check their own copy under their lock
+	if (!CanChangeSecondaryUserProgress(handle, false))
+		return false;
+
+	return m_serverPlayers.IncreaseProgress(playerId, handle, increase);
+}
+
+int32 UAchievementManagerSubSystem::IncreaseServerPlayersProgress(const TConstArrayView<FUniqueNetIdRepl> playerIds, const FAchievementHandle handle, const float increase)
+{
+	if (!CanChangeSecondaryUserProgress(handle, false))
+		return 0;
+
+	return m_serverPlayers.IncreaseProgressForPlayers(playerIds, handle, increase);
+}
+
+FAchievementProgress UAchievementManagerSubSystem::GetServerPlayerProgress(const FUniqueNetIdRepl& playerId, const FAchievementHandle handle) const
+{
+	FAchievementProgress progress;
+	if (!m_registry.IsValidHandle(handle) || !m_serverPlayers.GetProgress(playerId, handle, progress))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("No progress for achievement handle '%d' of player '%s'"), handle.GetIndex(), *playerId.ToString());
+	}
+	return progress;
+}
+
+void UAchievementManagerSubSystem::QueueServerPlayerSaves()
+{
+	m_timeSinceServerPlayerSave = 0.f;
+	m_serverPlayers.CollectDirtyPlayers(m_serverSaveQueue);
+}
+
+void UAchievementManagerSubSystem::SaveQueuedServerPlayers()
+{
+	const int32 saveCount = FMath::Min(m_serverSaveQueue.Num(), UAchievementPluginSettings::Get()->serverPlayerSavesPerFrame);
+	FAchievementProgressStore progress;
+	for (int32 index = 0; index < saveCount; ++index)
+	{
+		// players that left were already saved by RemoveServerPlayer
+		if (m_serverPlayers.ExportPlayer(m_serverSaveQueue[index], progress))
+		{
+			GetSaveManager()->SavePlayerProgressAsync(progress, m_serverSaveQueue[index]);
+		}
+	}
+	m_serverSaveQueue.RemoveAt(0, saveCount);
+}
+
+void UAchievementManagerSubSystem::QueueLocalUserUnlocks(const int32 row, const TArrayView<const int32> unlockedIndices)
+{
+	const int32 localUserIndex = m_localUsers.GetLocalUserIndex(row);
+	for (const int32 registryIndex : unlockedIndices)
+	{
+		m_localUserUnlocks.Emplace(localUserIndex, FAchievementHandle(registryIndex));
+		UE_LOG(AchievementLog, Log, TEXT("Unlocked achievement '%s' for local user %d"),
+			   *m_registry.GetEntry(FAchievementHandle(registryIndex)).achievementId.ToString(), localUserIndex);
+	}
+}
+
+void UAchievementManagerSubSystem::RefreshLocalUserComposites(const int32 row)
+{
+	TArray<int32> unlockedIndices;
+	m_localUsers.RefreshComposites(row, m_registry, unlockedIndices);
+	QueueLocalUserUnlocks(row, unlockedIndices);
+}
+
+void UAchievementManagerSubSystem::QueuePlatformWrite(const int32 registryIndex)
+{
+	if (!m_hasPendingPlatformWrite[registryIndex])
+	{
+		m_hasPendingPlatformWrite[registryIndex] = true;
+		m_pendingPlatformWrites.Add(registryIndex);
+	}
+}
+
+void UAchievementManagerSubSystem::MarkProgressChanged(const int32 registryIndex)
+{
+	m_bSnapshotDirty = true;
+	if (!m_hasChanged[registryIndex])
+	{
+		m_hasChanged[registryIndex] = true;
+		m_changedHandles.Add(FAchievementHandle(registryIndex));
+	}
+}
+
+void UAchievementManagerSubSystem::MarkUnlocked(const int32 registryIndex)
+{
+	// an achievement can only unlock once, so no duplicate check is needed
+	m_unlockedHandles.Add(FAchievementHandle(registryIndex));
+	MarkProgressChanged(registryIndex);
+}
+
+void UAchievementManagerSubSystem::DispatchAchievementEvents()
+{
+	// collected by the server shards from any thread, broadcast on the game thread
+	TArray<TPair<FUniqueNetIdRepl, FAchievementHandle>> serverPlayerUnlocks;
+	m_serverPlayers.CollectUnlocks(serverPlayerUnlocks);
+	for (const TPair<FUniqueNetIdRepl, FAchievementHandle>& unlock : serverPlayerUnlocks)
+	{
+		OnServerPlayerAchievementUnlocked.Broadcast(unlock.Key, unlock.Value);
+	}
+
+	if (m_localUserUnlocks.Num() > 0)
+	{
+		const TArray<TPair<int32, FAchievementHandle>> localUserUnlocks = MoveTemp(m_localUserUnlocks);
+		m_localUserUnlocks.Reset();
+		for (const TPair<int32, FAchievementHandle>& unlock : localUserUnlocks)
+		{
+			OnLocalUserAchievementUnlocked.Broadcast(unlock.Key, unlock.Value);
+		}
+	}
+
+	if (m_changedHandles.Num() == 0)
+		return;
+
+	// moved out first, listeners are allowed to change progress again (that ends up in the next frame's events)
+	TArray<FAchievementHandle> changedHandles = MoveTemp(m_changedHandles);
+	TArray<FAchievementHandle> unlockedHandles = MoveTemp(m_unlockedHandles);
+	m_changedHandles.Reset();
+	m_unlockedHandles.Reset();
+	for (const FAchievementHandle handle : changedHandles)
+	{
+		m_hasChanged[handle.GetIndex()] = false;
+	}
+
+	if (unlockedHandles.Num() > 0)
+	{
+		OnAchievementsUnlocked.Broadcast(unlockedHandles);
+	}
+	OnProgressChanged.Broadcast(changedHandles);
+
+	// only the subscribers of what actually changed
+	for (const FAchievementHandle handle : changedHandles)
+	{
+		if (m_listeners.HasListeners(handle.GetIndex()))
+		{
+			m_listeners.Notify(handle, m_progressStore.GetProgressStruct(m_registry.GetEntry(handle).progressIndex));
+		}
+	}
+}
+
+int32 UAchievementManagerSubSystem::SubscribeToAchievement(const FAchievementHandle handle, const FOnAchievementProgressUpdated& listener)
+{
+	if (!m_registry.IsValidHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid achievement handle '%d'"), handle.GetIndex());
+		return INDEX_NONE;
+	}
+	return m_listeners.Subscribe(handle, m_registry.GetEntry(handle).achievementId, listener);
+}
+
+int32 UAchievementManagerSubSystem::SubscribeToAchievement(const FName achievementId, const FOnAchievementProgressUpdated& listener)
+{
+	const FAchievementHandle handle = GetAchievementHandle(achievementId);
+	if (!handle.IsValid())
+	{
+		return INDEX_NONE;
+	}
+	return SubscribeToAchievement(handle, listener);
+}
+
+bool UAchievementManagerSubSystem::UnsubscribeFromAchievement(const int32 subscriptionId)
+{
+	return m_listeners.Unsubscribe(subscriptionId);
+}
+
+int32 UAchievementManagerSubSystem::UnsubscribeAllFromAchievements(const UObject* listenerObject)
+{
+	return m_listeners.UnsubscribeAll(listenerObject);
+}
+
+FAchievementStatHandle UAchievementManagerSubSystem::GetStatHandle(const FName statId) const
+{
+	const FAchievementStatHandle handle = m_registry.FindStatHandle(statId);
+	if (!handle.IsValid())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Stat with the name '%s' cannot be found!"), *statId.ToString());
+	}
+	return handle;
+}
+
+bool UAchievementManagerSubSystem::IncreaseStat(const FName statId, const double increase)
+{
+	const FAchievementStatHandle handle = GetStatHandle(statId);
+	if (!handle.IsValid())
+	{
+		return false;
+	}
+	return IncreaseStat(handle, increase);
+}
+
+bool UAchievementManagerSubSystem::IncreaseStat(const FAchievementStatHandle handle, const double increase)
+{
+	if (!m_registry.IsValidStatHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid stat handle '%d'"), handle.GetIndex());
+		return false;
+	}
+	return SetStat(handle, m_statStore.GetValue(m_registry.GetStatEntry(handle).valueIndex) + increase);
+}
+
+bool UAchievementManagerSubSystem::SetStat(const FAchievementStatHandle handle, const double value)
+{
+	if (!m_registry.IsValidStatHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid stat handle '%d'"), handle.GetIndex());
+		return false;
+	}
+
+	const FAchievementStatRegistryEntry& stat = m_registry.GetStatEntry(handle);
+	switch (stat.type)
+	{
+		case EAchievementStatType::Int:
+		{
+			ApplyStatValue(handle, FMath::RoundToDouble(value));
+			return true;
+		}
+		case EAchievementStatType::Float:
+		{
+			ApplyStatValue(handle, value);
+			return true;
+		}
+		default:
+		{
+			UE_LOG(AchievementLog, Error, TEXT("Stat '%s' is an average rate, use AddAverageRateSample instead"), *stat.statId.ToString());
+			return false;
+		}
+	}
+}
+
+bool UAchievementManagerSubSystem::AddAverageRateSample(const FAchievementStatHandle handle, const double count, const double seconds)
+{
+	if (!m_registry.IsValidStatHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid stat handle '%d'"), handle.GetIndex());
+		return false;
+	}
+
+	const FAchievementStatRegistryEntry& stat = m_registry.GetStatEntry(handle);
+	if (stat.type != EAchievementStatType::AverageRate)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Stat '%s' is not an average rate"), *stat.statId.ToString());
+		return false;
+	}
+	if (seconds <= 0.0)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Average rate samples for stat '%s' need a duration above 0"), *stat.statId.ToString());
+		return false;
+	}
+
+	const int32 statIndex = handle.GetIndex();
+	m_pendingRateCounts[statIndex] += count;
+	m_pendingRateSeconds[statIndex] += seconds;
+
+	m_statStore.SetDuration(stat.valueIndex, m_statStore.GetDuration(stat.valueIndex) + seconds);
+	ApplyStatValue(handle, m_statStore.GetValue(stat.valueIndex) + count);
+	return true;
+}
+
+double UAchievementManagerSubSystem::GetStatValue(const FAchievementStatHandle handle) const
+{
+	if (!m_registry.IsValidStatHandle(handle))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Invalid stat handle '%d'"), handle.GetIndex());
+		return 0.0;
+	}
+
+	const FAchievementStatRegistryEntry& stat = m_registry.GetStatEntry(handle);
+	if (stat.type == EAchievementStatType::AverageRate)
+	{
+		const double duration = m_statStore.GetDuration(stat.valueIndex);
+		return duration > 0.0 ? m_statStore.GetValue(stat.valueIndex) / duration : 0.0;
+	}
+	return m_statStore.GetValue(stat.valueIndex);
+}
+
+void UAchievementManagerSubSystem::ApplyStatValue(const FAchievementStatHandle handle, const double value)
+{
+	m_statStore.SetValue(m_registry.GetStatEntry(handle).valueIndex, value);
+	m_bSnapshotDirty = true;
+
+	const int32 statIndex = handle.GetIndex();
+	if (!m_hasPendingStatWrite[statIndex])
+	{
+		m_hasPendingStatWrite[statIndex] = true;
+		m_pendingStatWrites.Add(statIndex);
+	}
+
+	ApplyStatToWatchers(handle);
+	MarkConditionsDirty(statIndex);
+}
+
+void UAchievementManagerSubSystem::ApplyStatToWatchers(const FAchievementStatHandle handle)
+{
+	const double statValue = GetStatValue(handle);
+	const int32 statIndex = handle.GetIndex();
+
+	// the watchers are sorted by goal, so only the one at the cursor can be crossed next
+	const TConstArrayView<int32> watchers = m_registry.GetStatWatchers(handle);
+	const TConstArrayView<int32> goals = m_registry.GetStatWatcherGoals(handle);
+	int32& cursor = m_statThresholdCursors[statIndex];
+	while (cursor < goals.Num() && statValue >= goals[cursor])
+	{
+		const int32 registryIndex = watchers[cursor++];
+		if (!m_registry.IsLive(FAchievementHandle(registryIndex)))
+		{
+			m_diagnostics.RecordSkippedInactive(registryIndex);
+			continue;
+		}
+		if (!m_activeSet.IsActive(registryIndex))
+		{
+			m_diagnostics.RecordSkippedUnlocked(registryIndex);
+			continue;
+		}
+		m_diagnostics.RecordProgressUpdate(registryIndex);
+
+		// only the unlock itself goes to the platform, the progress is already covered by the stat
+		UnlockAchievement(registryIndex);
+	}
+
+	// the locked watchers only need their progress once per frame, not once per update
+	if (cursor < goals.Num() && !m_hasStaleStatProgress[statIndex])
+	{
+		m_hasStaleStatProgress[statIndex] = true;
+		m_staleStatProgress.Add(statIndex);
+	}
+}
+
+void UAchievementManagerSubSystem::SyncStatProgress()
+{
+	for (const int32 statIndex : m_staleStatProgress)
+	{
+		const FAchievementStatHandle handle(statIndex);
+		const float statValue = static_cast<float>(GetStatValue(handle));
+
+		// everything before the cursor is unlocked, everything after it has a goal above the value
+		const TConstArrayView<int32> watchers = m_registry.GetStatWatchers(handle);
+		for (int32 offset = m_statThresholdCursors[statIndex]; offset < watchers.Num(); ++offset)
+		{
+			if (!m_activeSet.IsActive(watchers[offset]))
+				continue;
+
+			const int32 index = m_registry.GetEntry(FAchievementHandle(watchers[offset])).progressIndex;
+			if (m_progressStore.GetProgress(index) != statValue)
+			{
+				m_progressStore.SetProgress(index, statValue);
+				MarkProgressChanged(watchers[offset]);
+			}
+		}
+		m_hasStaleStatProgress[statIndex] = false;
+	}
+	m_staleStatProgress.Reset();
+}
+
+void UAchievementManagerSubSystem::MarkConditionsDirty(const int32 statIndex)
+{
+	if (m_conditions.Num() == 0)
+		return;
+
+	for (const int32 conditionIndex : m_conditions.GetConditionsForStat(statIndex))
+	{
+		if (!m_hasDirtyCondition[conditionIndex])
+		{
+			m_hasDirtyCondition[conditionIndex] = true;
+			m_dirtyConditions.Add(conditionIndex);
+		}
+	}
+}
+
+void UAchievementManagerSubSystem::EvaluateDirtyConditions()
+{
+	for (const int32 conditionIndex : m_dirtyConditions)
+	{
+		m_hasDirtyCondition[conditionIndex] = false;
+
+		const int32 registryIndex = m_conditions.GetAchievementIndex(conditionIndex);
+		if (!m_activeSet.IsActive(registryIndex))
+			continue;
+
+		const bool bHolds = m_conditions.Evaluate(conditionIndex, [this](const int32 statIndex)
+		{
+			return GetStatValue(FAchievementStatHandle(statIndex));
+		});
+		if (bHolds)
+		{
+			m_diagnostics.RecordProgressUpdate(registryIndex);
+			UnlockAchievement(registryIndex);
+		}
+	}
+	m_dirtyConditions.Reset();
+}
+
+void UAchievementManagerSubSystem::RefreshStatAchievements()
+{
+	for (int32 statIndex = 0; statIndex < m_registry.NumStats(); ++statIndex)
+	{
+		const FAchievementStatHandle handle(statIndex);
+
+		// start at the lowest goal that is still locked, unlocks could have come from a save or older goals
+		const TConstArrayView<int32> watchers = m_registry.GetStatWatchers(handle);
+		int32& cursor = m_statThresholdCursors[statIndex];
+		cursor = 0;
+		while (cursor < watchers.Num() && !m_activeSet.IsActive(watchers[cursor]))
+		{
+			++cursor;
+		}
+
+		ApplyStatToWatchers(handle);
+	}
+	SyncStatProgress();
+}
+
+void UAchievementManagerSubSystem::ReportProgress(const FAchievementHandle handle, const float increase)
+{
+	// the handle is validated when the queue is drained, the registry must not be touched off the game thread
+	m_progressQueue->Enqueue(FAchievementQueuedProgress{handle.GetIndex(), increase});
+}
+
+void UAchievementManagerSubSystem::DrainProgressQueue()
+{
+	check(IsInGameThread());
+	if (!m_progressQueue)
+		return;
+
+	FAchievementQueuedProgress item;
+	while (m_progressQueue->Dequeue(item))
+	{
+		ApplyProgressIncrease(FAchievementHandle(item.registryIndex), item.delta);
+	}
+}
+
+void UAchievementManagerSubSystem::IncrementCounter(const FAchievementHandle handle, const int32 amount)
+{
+	// validated when merging, just like ReportProgress
+	if (!m_counterShards.Increment(handle.GetIndex(), amount))
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement handle '%d' cannot be used as a counter"), handle.GetIndex());
+	}
+}
+
+void UAchievementManagerSubSystem::MergeCounters()
+{
+	check(IsInGameThread());
+	m_timeSinceCounterMerge = 0.f;
+
+	m_counterShards.Merge([this](const int32 counterIndex, const int64 amount)
+	{
+		ApplyProgressIncrease(FAchievementHandle(counterIndex), static_cast<float>(amount));
+	});
+}
+
+void UAchievementManagerSubSystem::ApplyAccumulatedProgress()
+{
+	for (const int32 index : m_accumulatedIndices)
+	{
+		ApplyProgressIncrease(FAchievementHandle(index), m_accumulatedDeltas[index]);
+		m_accumulatedDeltas[index] = 0.f;
+		m_hasAccumulatedDelta[index] = false;
+	}
+	m_accumulatedIndices.Reset();
+}
+
+void UAchievementManagerSubSystem::Tick(float deltaTime)
+{
+	// apply everything reported from other threads in bulk
+	DrainProgressQueue();
+
+	m_timeSinceCounterMerge += deltaTime;
+	if (m_timeSinceCounterMerge >= UAchievementPluginSettings::Get()->counterMergeInterval)
+	{
+		MergeCounters();
+	}
+
+	// everything accumulated this frame gets applied once
+	ApplyAccumulatedProgress();
+	SyncStatProgress();
+	AdvanceWindows();
+	// every condition whose stats changed this frame gets evaluated once
+	EvaluateDirtyConditions();
+
+	// a set started or ended, only the live bits change, handles (and everything indexed by them) stay as they are
+	if (m_setSchedule.HasScheduledChange() && m_setSchedule.IsChangeDue(FDateTime::UtcNow()))
+	{
+		UE_LOG(AchievementLog, Log, TEXT("An achievement set started or ended, updating the live achievements"));
+		// writes queued for an achievement whose set ended still need its platform data
+		FlushPlatformProgress();
+		BuildLiveAchievements();
+		// the active set, stat cursors, composites and conditions pick up what started
+		InitializeAchievements();
+	}
+
+	// then send it all to the platform at once
+	FlushPlatformProgress();
+
+	// and tell gameplay/UI what changed, once per frame
+	DispatchAchievementEvents();
+
+	// saving is batched as well, however many changes happened in between
+	const float autoSaveInterval = UAchievementPluginSettings::Get()->autoSaveInterval;
+	if (autoSaveInterval > 0.f)
+	{
+		m_timeSinceAutoSave += deltaTime;
+		if (m_bSaveDirty && m_timeSinceAutoSave >= autoSaveInterval && GetSaveManager()->SaveProgressAsync(m_progressStore, m_statStore))
+		{
+			m_bSaveDirty = false;
+			m_timeSinceAutoSave = 0.f;
+		}
+	}
+
+	// other threads only see the progress through snapshots, stays dirty if every spare one is still pinned
+	if (m_bSnapshotDirty && m_snapshots.Publish(m_progressStore, m_statStore))
+	{
+		m_bSnapshotDirty = false;
+	}
+
+	// server player saves are batched per interval and spread over frames
+	if (m_serverPlayers.NumPlayers() > 0 || m_serverSaveQueue.Num() > 0)
+	{
+		m_timeSinceServerPlayerSave += deltaTime;
+		if (m_timeSinceServerPlayerSave >= UAchievementPluginSettings::Get()->serverPlayerSaveInterval)
+		{
+			QueueServerPlayerSaves();
+		}
+		SaveQueuedServerPlayers();
+	}
+
+	// periodic summary instead of a line per event, skipped when nothing happened
+	const float diagnosticsInterval = CVarAchievementDiagnosticsInterval.GetValueOnGameThread();
+	if (diagnosticsInterval > 0.f)
+	{
+		m_timeSinceDiagnosticsSummary += deltaTime;
+		if (m_timeSinceDiagnosticsSummary >= diagnosticsInterval)
+		{
+			m_timeSinceDiagnosticsSummary = 0.f;
+			if (m_diagnostics.HasActivity())
+			{
+				LogDiagnosticsSummary(true);
+			}
+		}
+	}
+}
+
+void UAchievementManagerSubSystem::LogDiagnosticsSummary(const bool bResetCounters)
+{
+	m_diagnostics.LogSummary(m_registry, bResetCounters);
+}
+
+void UAchievementManagerSubSystem::BenchmarkConditions(const int32 iterations) const
+{
+	if (m_conditions.Num() == 0)
+	{
+		UE_LOG(AchievementLog, Warning, TEXT("No achievement has an unlock condition, nothing to benchmark"));
+		return;
+	}
+
+	const auto getStatValue = [this](const int32 statIndex)
+	{
+		return GetStatValue(FAchievementStatHandle(statIndex));
+	};
+
+	int64 holdingCount = 0;
+	const double startTime = FPlatformTime::Seconds();
+	for (int32 iteration = 0; iteration < iterations; ++iteration)
+	{
+		for (int32 conditionIndex = 0; conditionIndex < m_conditions.Num(); ++conditionIndex)
+		{
+			holdingCount += m_conditions.Evaluate(conditionIndex, getStatValue) ? 1 : 0;
+		}
+	}
+	const double elapsedSeconds = FPlatformTime::Seconds() - startTime;
+
+	const int64 evaluations = static_cast<int64>(iterations) * m_conditions.Num();
+	UE_LOG(AchievementLog, Log, TEXT("Evaluated %d unlock conditions %d times in %.3f ms (%.1f ns per evaluation, %lld held)"),
+		   m_conditions.Num(), iterations, elapsedSeconds * 1000.0, elapsedSeconds * 1e9 / static_cast<double>(evaluations), holdingCount);
+}
+
+FAchievementHandle UAchievementManagerSubSystem::ResolveProgressChange(const FAchievementProgressChange& change) const
+{
+	if (change.handle.IsValid())
+	{
+		return change.handle;
+	}
+	return GetAchievementHandle(change.achievementId);
 }
 
 void UAchievementManagerSubSystem::OnWorldInitialized(const UWorld* world)
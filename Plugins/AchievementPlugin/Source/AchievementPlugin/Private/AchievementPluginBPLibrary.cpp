@@ -43,27 +43,152 @@ UAchievementManagerSubSystem* GetManager()
 //	return TArray<FString>();
 //}
 
-bool UAchievementPluginBPLibrary::IncreaseAchievementProgress(const FString& localAchievementId, const float change)
+bool UAchievementPluginBPLibrary::IncreaseAchievementProgress(const FName localAchievementId, const float change, const EAchievementUpdateMode mode)
 {
-	return GetManager()->IncreaseAchievementProgress(localAchievementId, change);
+	return GetManager()->IncreaseAchievementProgress(localAchievementId, change, mode);
+}
+
+FAchievementHandle UAchievementPluginBPLibrary::GetAchievementHandle(const FName localAchievementId)
+{
+	return GetManager()->GetAchievementHandle(localAchievementId);
+}
+
+bool UAchievementPluginBPLibrary::IsValidAchievementHandle(const FAchievementHandle& handle)
+{
+	return GetManager()->GetRegistry().IsValidHandle(handle);
+}
+
+FName UAchievementPluginBPLibrary::GetAchievementIdFromHandle(const FAchievementHandle& handle)
+{
+	return GetManager()->GetAchievementId(handle);
+}
+
+FAchievementProgress UAchievementPluginBPLibrary::GetAchievementProgressByHandle(const FAchievementHandle& handle)
+{
+	return GetManager()->GetAchievementProgress(handle);
+}
+
+int32 UAchievementPluginBPLibrary::SubscribeToAchievement(const FAchievementHandle& handle, const FOnAchievementProgressUpdated& listener)
+{
+	return GetManager()->SubscribeToAchievement(handle, listener);
+}
+
+bool UAchievementPluginBPLibrary::UnsubscribeFromAchievement(const int32 subscriptionId)
+{
+	return GetManager()->UnsubscribeFromAchievement(subscriptionId);
+}
+
+bool UAchievementPluginBPLibrary::IncreaseAchievementProgressByHandle(const FAchievementHandle& handle, const float change, const EAchievementUpdateMode mode)
+{
+	return GetManager()->IncreaseAchievementProgress(handle, change, mode);
+}
+
+void UAchievementPluginBPLibrary::IncrementAchievementCounter(const FAchievementHandle& handle, const int32 amount)
+{
+	GetManager()->IncrementCounter(handle, amount);
+}
+
+int32 UAchievementPluginBPLibrary::IncreaseAchievementProgressBatch(const TArray<FAchievementProgressChange>& changes)
+{
+	return GetManager()->IncreaseAchievementProgressBatch(changes);
+}
+
+int32 UAchievementPluginBPLibrary::ReportGameplayEvent(const FGameplayTag eventTag, const float magnitude)
+{
+	return GetManager()->ReportGameplayEvent(eventTag, magnitude);
+}
+
+void UAchievementPluginBPLibrary::ResetAchievementScope(const EAchievementScope scope)
+{
+	GetManager()->ResetAchievementScope(scope);
+}
+
+bool UAchievementPluginBPLibrary::AddLocalUser(const int32 localUserIndex)
+{
+	return GetManager()->AddLocalUser(localUserIndex);
+}
+
+bool UAchievementPluginBPLibrary::RemoveLocalUser(const int32 localUserIndex, const bool bSave)
+{
+	return GetManager()->RemoveLocalUser(localUserIndex, bSave);
+}
+
+bool UAchievementPluginBPLibrary::IncreaseAchievementProgressForUser(const int32 localUserIndex, const FAchievementHandle& handle, const float change)
+{
+	return GetManager()->IncreaseAchievementProgressForUser(localUserIndex, handle, change);
+}
+
+FAchievementProgress UAchievementPluginBPLibrary::GetAchievementProgressForUser(const int32 localUserIndex, const FAchievementHandle& handle)
+{
+	return GetManager()->GetAchievementProgressForUser(localUserIndex, handle);
+}
+
+bool UAchievementPluginBPLibrary::IncreaseServerPlayerProgress(const FUniqueNetIdRepl& playerId, const FAchievementHandle& handle, const float change)
+{
+	return GetManager()->IncreaseServerPlayerProgress(playerId, handle, change);
+}
+
+int32 UAchievementPluginBPLibrary::IncreaseServerPlayersProgress(const TArray<FUniqueNetIdRepl>& playerIds, const FAchievementHandle& handle, const float change)
+{
+	return GetManager()->IncreaseServerPlayersProgress(playerIds, handle, change);
+}
+
+FAchievementStatHandle UAchievementPluginBPLibrary::GetStatHandle(const FName statId)
+{
+	return GetManager()->GetStatHandle(statId);
+}
+
+bool UAchievementPluginBPLibrary::IncreaseStat(const FName statId, const float increase)
+{
+	return GetManager()->IncreaseStat(statId, increase);
+}
+
+bool UAchievementPluginBPLibrary::IncreaseStatByHandle(const FAchievementStatHandle& handle, const float increase)
+{
+	return GetManager()->IncreaseStat(handle, increase);
+}
+
+bool UAchievementPluginBPLibrary::SetStat(const FAchievementStatHandle& handle, const float value)
+{
+	return GetManager()->SetStat(handle, value);
+}
+
+bool UAchievementPluginBPLibrary::AddAverageRateSample(const FAchievementStatHandle& handle, const float count, const float seconds)
+{
+	return GetManager()->AddAverageRateSample(handle, count, seconds);
+}
+
+float UAchievementPluginBPLibrary::GetStatValue(const FAchievementStatHandle& handle)
+{
+	return static_cast<float>(GetManager()->GetStatValue(handle));
+}
+
+FText UAchievementPluginBPLibrary::FormatAchievementUnlockTime(const FAchievementProgress& progress)
+{
+	if (progress.unlockedTicks == FAchievementProgress::NeverUnlockedTicks)
+	{
+		return NSLOCTEXT("AchievementPlugin", "NeverUnlocked", "Never");
+	}
+	// the ticks are UTC, AsDateTime converts them to the local time zone
+	return FText::AsDateTime(progress.GetUnlockedTimeUtc());
 }
 
 bool UAchievementPluginBPLibrary::SaveAchievementProgressAsync()
 {
 	const auto* manager = GetManager();
-	return GetManager()->GetSaveManager()->SaveProgressAsync(manager->achievementsProgress);
+	return GetManager()->GetSaveManager()->SaveProgressAsync(manager->GetProgressStore(), manager->GetStatStore());
 }
 
 bool UAchievementPluginBPLibrary::SaveAchievementProgress()
 {
 	const auto* manager = GetManager();
-	return manager->GetSaveManager()->SaveProgress(manager->achievementsProgress);
+	return manager->GetSaveManager()->SaveProgress(manager->GetProgressStore(), manager->GetStatStore());
 }
 
 bool UAchievementPluginBPLibrary::LoadAchievementProgress()
 {
 	auto* manager = GetManager();
-	manager->achievementsProgress = manager->GetSaveManager()->LoadProgress();
+	manager->GetSaveManager()->LoadProgress(manager->GetProgressStore(), manager->GetStatStore());
 
 	// remove any deleted achievements
 	manager->CleanupAchievements();
@@ -79,10 +204,14 @@ bool UAchievementPluginBPLibrary::DeleteSingleAchievementProgress(const FString&
 	if (auto* manager = GetManager())
 	{
 		const auto linkID = UAchievementPluginSettings::Get()->GetLinkIDByAchievementID(achievementID);
-		if (manager->achievementsProgress.Find(linkID))
+		auto& progressStore = manager->GetProgressStore();
+		const int32 progressIndex = progressStore.FindIndex(linkID);
+		if (progressIndex != INDEX_NONE)
 		{
 			// set the element to be empty
-			manager->achievementsProgress[linkID] = FAchievementProgress();
+			progressStore.Reset(progressIndex);
+			// the achievement is locked again
+			manager->InitializeAchievements();
 
 			UE_LOG(AchievementLog, Log, TEXT("Reset achievement progress for '%s'"), *achievementID);
 			return true;
@@ -100,10 +229,12 @@ bool UAchievementPluginBPLibrary::DeleteAllAchievementProgress(const bool platfo
 {
 	if (auto* manager = GetManager())
 	{
-		auto& progress = manager->achievementsProgress;
+		auto& progress = manager->GetProgressStore();
 		const int32 deletedCount = progress.Num();
 
 		progress.Empty();
+		// stats would unlock the watching achievements again
+		manager->GetStatStore().Empty();
 		manager->InitializeAchievements();
 
 		UE_LOG(AchievementLog, Log, TEXT("Deleted all achievement progress for' %d' entries"), deletedCount);
@@ -0,0 +1,95 @@
+#include "AchievementProgressQueue.h"
+
+// bounded ring based on Dmitry Vyukov's MPMC queue, every cell's sequence tells whose turn it is:
+// sequence == position means free for the producer at that position, position + 1 means filled for the consumer
+
+FAchievementProgressQueue::FAchievementProgressQueue(const uint32 capacity)
+{
+	const uint32 roundedCapacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(capacity, 2));
+	m_mask = roundedCapacity - 1;
+
+	m_cells = new FCell[roundedCapacity];
+	for (uint32 index = 0; index < roundedCapacity; ++index)
+	{
+		m_cells[index].sequence.store(index, std::memory_order_relaxed);
+	}
+}
+
+FAchievementProgressQueue::~FAchievementProgressQueue()
+{
+	delete[] m_cells;
+}
+
+void FAchievementProgressQueue::Enqueue(const FAchievementQueuedProgress& item)
+{
+	if (!TryEnqueueRing(item))
+	{
+		// the ring is full, take the (allocating) slow path rather than losing progress
+		m_overflow.Enqueue(item);
+	}
+}
+
+bool FAchievementProgressQueue::Dequeue(FAchievementQueuedProgress& outItem)
+{
+	if (TryDequeueRing(outItem))
+	{
+		return true;
+	}
+
+	if (TOptional<FAchievementQueuedProgress> overflowItem = m_overflow.Dequeue())
+	{
+		outItem = overflowItem.GetValue();
+		return true;
+	}
+	return false;
+}
+
+bool FAchievementProgressQueue::TryEnqueueRing(const FAchievementQueuedProgress& item)
+{
+	uint32 position = m_enqueuePosition.load(std::memory_order_relaxed);
+	for (;;)
+	{
+		FCell& cell = m_cells[position & m_mask];
+		const uint32 sequence = cell.sequence.load(std::memory_order_acquire);
+		const int32 difference = static_cast<int32>(sequence - position);
+
+		if (difference == 0)
+		{
+			// the cell is free, try to claim it
+			if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				cell.item = item;
+				cell.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+			// another producer got there first, position has been reloaded by the CAS
+		}
+		else if (difference < 0)
+		{
+			// the consumer has not freed this cell yet, so the ring is full
+			return false;
+		}
+		else
+		{
+			position = m_enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool FAchievementProgressQueue::TryDequeueRing(FAchievementQueuedProgress& outItem)
+{
+	FCell& cell = m_cells[m_dequeuePosition & m_mask];
+	const uint32 sequence = cell.sequence.load(std::memory_order_acquire);
+
+	// either empty or a producer is still writing this cell, it will be picked up next time
+	if (static_cast<int32>(sequence - (m_dequeuePosition + 1)) != 0)
+	{
+		return false;
+	}
+
+	outItem = cell.item;
+	// hand the cell back to producers one lap later
+	cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+	++m_dequeuePosition;
+	return true;
+}
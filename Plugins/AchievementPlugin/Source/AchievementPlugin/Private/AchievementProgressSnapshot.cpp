@@ -0,0 +1,41 @@
+#include "AchievementProgressSnapshot.h"
+
+bool FAchievementSnapshotBuffer::Publish(const FAchievementProgressStore& progress, const FAchievementStatStore& stats)
+{
+	// only this thread changes the current slot, readers never write into any slot
+	const int32 currentSlot = m_currentSlot.load(std::memory_order_relaxed);
+	for (int32 slotIndex = 0; slotIndex < NumSlots; ++slotIndex)
+	{
+		FSlot& slot = m_slots[slotIndex];
+		if (slotIndex == currentSlot || slot.pins.load(std::memory_order_seq_cst) != 0)
+			continue;
+
+		// the slot isn't current, a reader that pins it now notices that and lets go again
+		// copying into the old slot reuses its allocations
+		slot.snapshot.version = m_nextVersion++;
+		slot.snapshot.progress = progress;
+		slot.snapshot.stats = stats;
+
+		m_currentSlot.store(slotIndex, std::memory_order_seq_cst);
+		return true;
+	}
+	return false;
+}
+
+FAchievementSnapshotBuffer::FPin FAchievementSnapshotBuffer::Pin() const
+{
+	for (;;)
+	{
+		const int32 currentSlot = m_currentSlot.load(std::memory_order_seq_cst);
+		if (currentSlot == INDEX_NONE)
+			return FPin();
+
+		// pin first, then make sure it is still the current slot, otherwise the game thread could be writing into it
+		const FSlot& slot = m_slots[currentSlot];
+		slot.pins.fetch_add(1, std::memory_order_seq_cst);
+		if (m_currentSlot.load(std::memory_order_seq_cst) == currentSlot)
+			return FPin(&slot);
+
+		slot.pins.fetch_sub(1, std::memory_order_release);
+	}
+}
@@ -0,0 +1,133 @@
+#include "AchievementProgressStore.h"
+
+int32 FAchievementProgressStore::FindOrAdd(const int32 linkID, bool* bOutWasAdded)
+{
+	if (const int32* existing = m_indexByLinkID.Find(linkID))
+	{
+		if (bOutWasAdded)
+			*bOutWasAdded = false;
+		return *existing;
+	}
+
+	const int32 index = m_linkIDs.Add(linkID);
+	m_progress.Add(0.f);
+	m_unlocked.Add(false);
+	m_unlockedTicks.Add(NeverUnlockedTicks);
+	m_transient.Add(false);
+	m_indexByLinkID.Add(linkID, index);
+
+	if (bOutWasAdded)
+		*bOutWasAdded = true;
+	return index;
+}
+
+void FAchievementProgressStore::Merge(const FAchievementProgressStore& other)
+{
+	for (int32 otherIndex = 0; otherIndex < other.Num(); ++otherIndex)
+	{
+		const int32 index = FindOrAdd(other.GetLinkID(otherIndex));
+		m_progress[index] = FMath::Max(m_progress[index], other.GetProgress(otherIndex));
+		// the earlier unlock wins, that is when it really happened
+		if (other.IsUnlocked(otherIndex) && (!m_unlocked[index] || other.GetUnlockedTicks(otherIndex) < m_unlockedTicks[index]))
+		{
+			Unlock(index, other.GetUnlockedTicks(otherIndex));
+		}
+	}
+}
+
+void FAchievementProgressStore::Reset(const int32 index)
+{
+	m_progress[index] = 0.f;
+	m_unlocked[index] = false;
+	m_unlockedTicks[index] = NeverUnlockedTicks;
+}
+
+void FAchievementProgressStore::Empty()
+{
+	m_linkIDs.Empty();
+	m_progress.Empty();
+	m_unlocked.Empty();
+	m_unlockedTicks.Empty();
+	m_transient.Empty();
+	m_indexByLinkID.Empty();
+}
+
+int32 FAchievementProgressStore::RemoveAll(const TFunctionRef<bool(int32 linkID)> predicate)
+{
+	// compact all columns in a single pass, keeping the order of the remaining entries
+	int32 writeIndex = 0;
+	for (int32 readIndex = 0; readIndex < m_linkIDs.Num(); ++readIndex)
+	{
+		if (predicate(m_linkIDs[readIndex]))
+			continue;
+
+		if (writeIndex != readIndex)
+		{
+			m_linkIDs[writeIndex] = m_linkIDs[readIndex];
+			m_progress[writeIndex] = m_progress[readIndex];
+			m_unlocked[writeIndex] = static_cast<bool>(m_unlocked[readIndex]);
+			m_unlockedTicks[writeIndex] = m_unlockedTicks[readIndex];
+			m_transient[writeIndex] = static_cast<bool>(m_transient[readIndex]);
+		}
+		++writeIndex;
+	}
+
+	const int32 removedCount = m_linkIDs.Num() - writeIndex;
+	if (removedCount > 0)
+	{
+		m_linkIDs.SetNum(writeIndex);
+		m_progress.SetNum(writeIndex);
+		m_unlocked.SetNumUninitialized(writeIndex);
+		m_unlockedTicks.SetNum(writeIndex);
+		m_transient.SetNumUninitialized(writeIndex);
+
+		m_indexByLinkID.Reset();
+		for (int32 index = 0; index < m_linkIDs.Num(); ++index)
+		{
+			m_indexByLinkID.Add(m_linkIDs[index], index);
+		}
+	}
+	return removedCount;
+}
+
+FAchievementProgress FAchievementProgressStore::GetProgressStruct(const int32 index) const
+{
+	FAchievementProgress progress;
+	progress.progress = m_progress[index];
+	progress.bIsAchievementUnlocked = m_unlocked[index];
+	progress.unlockedTicks = m_unlockedTicks[index];
+	return progress;
+}
+
+void FAchievementProgressStore::SetProgressStruct(const int32 index, const FAchievementProgress& progress)
+{
+	m_progress[index] = progress.progress;
+	m_unlocked[index] = progress.bIsAchievementUnlocked;
+	m_unlockedTicks[index] = progress.unlockedTicks;
+}
+
+TMap<int32, FAchievementProgress> FAchievementProgressStore::ToMap() const
+{
+	TMap<int32, FAchievementProgress> progressMap;
+	progressMap.Reserve(m_linkIDs.Num());
+	for (int32 index = 0; index < m_linkIDs.Num(); ++index)
+	{
+		progressMap.Add(m_linkIDs[index], GetProgressStruct(index));
+	}
+	return progressMap;
+}
+
+void FAchievementProgressStore::FromMap(const TMap<int32, FAchievementProgress>& progressMap)
+{
+	Empty();
+	m_linkIDs.Reserve(progressMap.Num());
+	m_progress.Reserve(progressMap.Num());
+	m_unlocked.Reserve(progressMap.Num());
+	m_unlockedTicks.Reserve(progressMap.Num());
+	m_indexByLinkID.Reserve(progressMap.Num());
+
+	for (const auto& progressPair : progressMap)
+	{
+		SetProgressStruct(FindOrAdd(progressPair.Key), progressPair.Value);
+	}
+}
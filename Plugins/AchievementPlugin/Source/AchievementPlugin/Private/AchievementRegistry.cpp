@@ -0,0 +1,346 @@
+#include "AchievementRegistry.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementProgressStore.h"
+#include "AchievementStatStore.h"
+
+void FAchievementRegistry::Build(const TMap<FString, FAchievementData>& achievementsData, const TMap<FString, FAchievementStatData>& statsData)
+{
+	Empty();
+
+	// stats first, so achievements can resolve the stat they watch
+	m_stats.Reserve(statsData.Num());
+	m_statIndexByStatId.Reserve(statsData.Num());
+	for (const auto& statPair : statsData)
+	{
+		FAchievementStatRegistryEntry& stat = m_stats.AddDefaulted_GetRef();
+		stat.statId = FName(*statPair.Key);
+		stat.type = statPair.Value.type;
+		stat.platformData = statPair.Value.platformData;
+
+		m_statIndexByStatId.Add(stat.statId, m_stats.Num() - 1);
+	}
+
+	m_entries.Reserve(achievementsData.Num());
+	m_indexByAchievementId.Reserve(achievementsData.Num());
+
+	// the dependency rules can only be resolved once every achievement has an index
+	TArray<const FAchievementData*> sourceData;
+	sourceData.Reserve(achievementsData.Num());
+
+	int32 highestLinkID = INDEX_NONE;
+	for (const auto& achievementPair : achievementsData)
+	{
+		sourceData.Add(&achievementPair.Value);
+		FAchievementRegistryEntry& entry = m_entries.AddDefaulted_GetRef();
+		entry.achievementId = FName(*achievementPair.Key);
+		entry.linkID = achievementPair.Value.GetLinkID();
+		entry.progressGoal = achievementPair.Value.progressGoal;
+		entry.platformData = achievementPair.Value.platformData;
+		entry.achievementSet = achievementPair.Value.achievementSet;
+
+		const FName watchedStat = achievementPair.Value.watchedStat;
+		if (!watchedStat.IsNone())
+		{
+			if (const int32* statIndex = m_statIndexByStatId.Find(watchedStat))
+			{
+				entry.statIndex = *statIndex;
+				++m_stats[*statIndex].watcherCount;
+			}
+			else
+			{
+				UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' watches stat '%s' which does not exist"), *entry.achievementId.ToString(), *watchedStat.ToString());
+			}
+		}
+
+		m_indexByAchievementId.Add(entry.achievementId, m_entries.Num() - 1);
+		highestLinkID = FMath::Max(highestLinkID, entry.linkID);
+	}
+
+	m_handleIndexByLinkID.Init(INDEX_NONE, highestLinkID + 1);
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		const FAchievementRegistryEntry& entry = m_entries[index];
+		if (!m_handleIndexByLinkID.IsValidIndex(entry.linkID))
+			continue;
+
+		if (m_handleIndexByLinkID[entry.linkID] != INDEX_NONE)
+		{
+			UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' shares LinkID '%d' with another achievement"), *entry.achievementId.ToString(), entry.linkID);
+		}
+		m_handleIndexByLinkID[entry.linkID] = index;
+	}
+
+	// lay the watchers out per stat, the counts were gathered above
+	int32 watcherOffset = 0;
+	for (FAchievementStatRegistryEntry& stat : m_stats)
+	{
+		stat.firstWatcher = watcherOffset;
+		watcherOffset += stat.watcherCount;
+		stat.watcherCount = 0;
+	}
+	m_statWatchers.SetNumUninitialized(watcherOffset);
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		const int32 statIndex = m_entries[index].statIndex;
+		if (statIndex == INDEX_NONE)
+			continue;
+
+		FAchievementStatRegistryEntry& stat = m_stats[statIndex];
+		m_statWatchers[stat.firstWatcher + stat.watcherCount++] = index;
+	}
+
+	// sort every range by goal, stat updates only ever look at the lowest goal that is still locked
+	m_statWatcherGoals.SetNumUninitialized(m_statWatchers.Num());
+	for (const FAchievementStatRegistryEntry& stat : m_stats)
+	{
+		TArrayView<int32> watchers(m_statWatchers.GetData() + stat.firstWatcher, stat.watcherCount);
+		watchers.StableSort([this](const int32 a, const int32 b)
+		{
+			return m_entries[a].progressGoal < m_entries[b].progressGoal;
+		});
+		for (int32 offset = 0; offset < stat.watcherCount; ++offset)
+		{
+			m_statWatcherGoals[stat.firstWatcher + offset] = m_entries[watchers[offset]].progressGoal;
+		}
+	}
+
+	BuildDependencyGraph(sourceData);
+
+	// windows go last, stat-driven and composite achievements don't count progress themselves
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		FAchievementRegistryEntry& entry = m_entries[index];
+		const FAchievementWindowSettings& window = sourceData[index]->window;
+		if (!window.IsSet())
+			continue;
+
+		if (entry.statIndex != INDEX_NONE || entry.IsComposite())
+		{
+			UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' has a window but does not count its own progress, the window is ignored"), *entry.achievementId.ToString());
+			continue;
+		}
+		entry.window = window;
+		entry.windowIndex = m_windowedAchievements.Add(index);
+	}
+	m_isLive.Init(true, m_entries.Num());
+
+	UE_LOG(AchievementLog, Log, TEXT("Built achievement registry with %d achievements (%d composites) and %d stats"), m_entries.Num(), m_compositeOrder.Num(), m_stats.Num());
+}
+
+void FAchievementRegistry::Empty()
+{
+	m_entries.Empty();
+	m_isLive.Empty();
+	m_indexByAchievementId.Empty();
+	m_handleIndexByLinkID.Empty();
+	m_stats.Empty();
+	m_statIndexByStatId.Empty();
+	m_statWatchers.Empty();
+	m_statWatcherGoals.Empty();
+	m_dependencies.Empty();
+	m_dependents.Empty();
+	m_compositeOrder.Empty();
+	m_windowedAchievements.Empty();
+}
+
+void FAchievementRegistry::BuildDependencyGraph(const TConstArrayView<const FAchievementData*> sourceData)
+{
+	// resolve the names first
+	TArray<TArray<int32>> dependencyLists;
+	dependencyLists.SetNum(m_entries.Num());
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		const FAchievementDependencyRule& rule = sourceData[index]->dependencies;
+		if (!rule.IsSet())
+			continue;
+
+		FAchievementRegistryEntry& entry = m_entries[index];
+		if (entry.statIndex != INDEX_NONE)
+		{
+			UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' watches a stat, its dependencies are ignored"), *entry.achievementId.ToString());
+			continue;
+		}
+
+		for (const FName& requiredId : rule.requiredAchievements)
+		{
+			const FAchievementHandle required = FindHandle(requiredId);
+			if (!required.IsValid())
+			{
+				UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' depends on '%s' which does not exist"), *entry.achievementId.ToString(), *requiredId.ToString());
+				continue;
+			}
+			dependencyLists[index].AddUnique(required.GetIndex());
+		}
+
+		const int32 dependencyCount = dependencyLists[index].Num();
+		entry.requiredDependencies = rule.requiredCount == 0 ? dependencyCount : FMath::Min(rule.requiredCount, dependencyCount);
+		if (entry.IsComposite())
+		{
+			entry.progressGoal = entry.requiredDependencies;
+		}
+	}
+
+	// Kahn's algorithm, whatever is left with unresolved dependencies afterwards is part of a cycle
+	TArray<int32> pendingDependencies;
+	pendingDependencies.SetNumZeroed(m_entries.Num());
+	TArray<TArray<int32>> dependentLists;
+	dependentLists.SetNum(m_entries.Num());
+	TArray<int32> readyIndices;
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		pendingDependencies[index] = dependencyLists[index].Num();
+		for (const int32 dependency : dependencyLists[index])
+		{
+			dependentLists[dependency].Add(index);
+		}
+		if (pendingDependencies[index] == 0)
+		{
+			readyIndices.Add(index);
+		}
+	}
+	for (int32 readIndex = 0; readIndex < readyIndices.Num(); ++readIndex)
+	{
+		const int32 index = readyIndices[readIndex];
+		if (m_entries[index].IsComposite())
+		{
+			m_compositeOrder.Add(index);
+		}
+		for (const int32 dependent : dependentLists[index])
+		{
+			if (--pendingDependencies[dependent] == 0)
+			{
+				readyIndices.Add(dependent);
+			}
+		}
+	}
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		if (pendingDependencies[index] == 0)
+			continue;
+
+		UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' is part of (or depends on) a dependency cycle, its dependencies are ignored"), *m_entries[index].achievementId.ToString());
+		dependencyLists[index].Empty();
+		m_entries[index].requiredDependencies = 0;
+		m_entries[index].progressGoal = sourceData[index]->progressGoal;
+	}
+
+	// flatten both directions, dropped (cyclic) edges are left out
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		FAchievementRegistryEntry& entry = m_entries[index];
+		entry.firstDependency = m_dependencies.Num();
+		entry.dependencyCount = dependencyLists[index].Num();
+		m_dependencies.Append(dependencyLists[index]);
+	}
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		FAchievementRegistryEntry& entry = m_entries[index];
+		entry.firstDependent = m_dependents.Num();
+		for (const int32 dependent : dependentLists[index])
+		{
+			if (m_entries[dependent].IsComposite())
+			{
+				m_dependents.Add(dependent);
+			}
+		}
+		entry.dependentCount = m_dependents.Num() - entry.firstDependent;
+	}
+}
+
+void FAchievementRegistry::SetLiveAchievements(const TBitArray<>& isLive, const TMap<FString, FAchievementData>& achievementsData)
+{
+	for (int32 index = 0; index < m_entries.Num(); ++index)
+	{
+		const bool bIsLive = isLive[index];
+		if (bIsLive == m_isLive[index])
+			continue;
+
+		FAchievementRegistryEntry& entry = m_entries[index];
+		if (bIsLive)
+		{
+			if (const FAchievementData* achievement = achievementsData.Find(entry.achievementId.ToString()))
+			{
+				entry.platformData = achievement->platformData;
+			}
+			m_indexByAchievementId.Add(entry.achievementId, index);
+			if (m_handleIndexByLinkID.IsValidIndex(entry.linkID))
+			{
+				m_handleIndexByLinkID[entry.linkID] = index;
+			}
+		}
+		else
+		{
+			// nothing gets uploaded for it anymore, no need to keep its platform IDs around
+			entry.platformData = FAchievementPlatformData();
+			m_indexByAchievementId.Remove(entry.achievementId);
+			if (m_handleIndexByLinkID.IsValidIndex(entry.linkID) && m_handleIndexByLinkID[entry.linkID] == index)
+			{
+				m_handleIndexByLinkID[entry.linkID] = INDEX_NONE;
+			}
+		}
+		m_isLive[index] = bIsLive;
+	}
+}
+
+int32 FAchievementRegistry::BindProgress(FAchievementProgressStore& store)
+{
+	int32 addedCount = 0;
+	for (FAchievementRegistryEntry& entry : m_entries)
+	{
+		bool bWasAdded = false;
+		entry.progressIndex = store.FindOrAdd(entry.linkID, &bWasAdded);
+		store.SetTransient(entry.progressIndex, entry.windowIndex != INDEX_NONE);
+		if (bWasAdded)
+		{
+			UE_LOG(AchievementLog, Log, TEXT("Created a new achievement Progress for '%s'"), *entry.achievementId.ToString());
+			++addedCount;
+		}
+	}
+	return addedCount;
+}
+
+int32 FAchievementRegistry::BindStats(FAchievementStatStore& store)
+{
+	int32 addedCount = 0;
+	for (FAchievementStatRegistryEntry& stat : m_stats)
+	{
+		bool bWasAdded = false;
+		stat.valueIndex = store.FindOrAdd(stat.statId, &bWasAdded);
+		if (bWasAdded)
+		{
+			UE_LOG(AchievementLog, Log, TEXT("Created a new stat value for '%s'"), *stat.statId.ToString());
+			++addedCount;
+		}
+	}
+	return addedCount;
+}
+
+FAchievementHandle FAchievementRegistry::FindHandle(const FName achievementId) const
+{
+	if (const int32* index = m_indexByAchievementId.Find(achievementId))
+	{
+		return FAchievementHandle(*index);
+	}
+	return FAchievementHandle();
+}
+
+FAchievementHandle FAchievementRegistry::FindHandle(const FString& achievementId) const
+{
+	// FNAME_Find never adds to the name table, unknown strings simply aren't achievements
+	const FName achievementName(*achievementId, FNAME_Find);
+	if (achievementName.IsNone())
+	{
+		return FAchievementHandle();
+	}
+	return FindHandle(achievementName);
+}
+
+FAchievementStatHandle FAchievementRegistry::FindStatHandle(const FName statId) const
+{
+	if (const int32* index = m_statIndexByStatId.Find(statId))
+	{
+		return FAchievementStatHandle(*index);
+	}
+	return FAchievementStatHandle();
+}
@@ -0,0 +1,285 @@
+#include "AchievementServerPlayerStore.h"
+
+#include "Async/ParallelFor.h"
+#include "AchievementLogCategory.h"
+#include "AchievementProgressStore.h"
+#include "AchievementRegistry.h"
+#include <atomic>
+
+void FAchievementServerPlayerStore::Build(const FAchievementRegistry& registry)
+{
+	// the subsystem's registry is rebuilt in place, this only ever changes the first time
+	if (m_registry != &registry)
+	{
+		m_registry = &registry;
+	}
+
+	for (FShard& shard : m_shards)
+	{
+		FScopeLock scopeLock(&shard.lock);
+
+		// the rows are in registry order, keep the progress by LinkID while the order changes
+		// the rows remember the old LinkIDs, the registry itself was already rebuilt at this point
+		TArray<FAchievementProgressStore> rowProgress;
+		rowProgress.SetNum(shard.playerIds.Num());
+		for (int32 row = 0; row < shard.playerIds.Num(); ++row)
+		{
+			shard.progress.Export(row, rowProgress[row]);
+		}
+
+		// the live achievements are copied into the rows' layout here, under the lock the updates take as well
+		shard.progress.Build(registry);
+		for (int32 row = 0; row < shard.playerIds.Num(); ++row)
+		{
+			shard.progress.Import(row, registry, rowProgress[row]);
+
+			// composites of a set that just started can already be satisfied
+			shard.unlockedScratch.Reset();
+			shard.progress.RefreshComposites(row, registry, shard.unlockedScratch);
+			for (const int32 registryIndex : shard.unlockedScratch)
+			{
+				shard.unlocks.Emplace(shard.playerIds[row], FAchievementHandle(registryIndex));
+			}
+		}
+	}
+}
+
+void FAchievementServerPlayerStore::Empty()
+{
+	for (FShard& shard : m_shards)
+	{
+		FScopeLock scopeLock(&shard.lock);
+		shard.progress.Empty();
+		shard.playerIds.Empty();
+		shard.rowByPlayer.Empty();
+		shard.dirtyRows.Empty();
+		shard.loadedRows.Empty();
+		shard.unlocks.Empty();
+	}
+}
+
+bool FAchievementServerPlayerStore::AddPlayer(const FUniqueNetIdRepl& playerId)
+{
+	FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+	if (shard.rowByPlayer.Contains(playerId))
+		return false;
+
+	const int32 row = shard.progress.AddUser(INDEX_NONE);
+	shard.playerIds.Add(playerId);
+	shard.rowByPlayer.Add(playerId, row);
+	shard.dirtyRows.Add(false);
+	shard.loadedRows.Add(false);
+	return true;
+}
+
+bool FAchievementServerPlayerStore::RemovePlayer(const FUniqueNetIdRepl& playerId)
+{
+	FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+
+	int32 row = INDEX_NONE;
+	if (!shard.rowByPlayer.RemoveAndCopyValue(playerId, row))
+		return false;
+
+	// the last row moves into the gap, same for its id and flags
+	const int32 lastRow = shard.playerIds.Num() - 1;
+	shard.progress.RemoveRow(row);
+	shard.playerIds.RemoveAtSwap(row);
+	shard.dirtyRows[row] = static_cast<bool>(shard.dirtyRows[lastRow]);
+	shard.dirtyRows.RemoveAt(lastRow);
+	shard.loadedRows[row] = static_cast<bool>(shard.loadedRows[lastRow]);
+	shard.loadedRows.RemoveAt(lastRow);
+	if (row != lastRow)
+	{
+		shard.rowByPlayer[shard.playerIds[row]] = row;
+	}
+	return true;
+}
+
+bool FAchievementServerPlayerStore::HasPlayer(const FUniqueNetIdRepl& playerId) const
+{
+	const FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+	return shard.rowByPlayer.Contains(playerId);
+}
+
+bool FAchievementServerPlayerStore::IsPlayerLoaded(const FUniqueNetIdRepl& playerId) const
+{
+	const FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+
+	const int32* row = shard.rowByPlayer.Find(playerId);
+	return row && shard.loadedRows[*row];
+}
+
+int32 FAchievementServerPlayerStore::NumPlayers() const
+{
+	int32 count = 0;
+	for (const FShard& shard : m_shards)
+	{
+		FScopeLock scopeLock(&shard.lock);
+		count += shard.playerIds.Num();
+	}
+	return count;
+}
+
+bool FAchievementServerPlayerStore::IncreaseProgress(const FUniqueNetIdRepl& playerId, const FAchievementHandle handle, const float increase)
+{
+	FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+
+	// the live check has to happen under the lock, the rows only have columns for what was live at the last Build
+	if (!shard.progress.IsLive(handle.GetIndex()))
+	{
+		LogInactive(handle);
+		return false;
+	}
+
+	const int32* row = shard.rowByPlayer.Find(playerId);
+	if (!row)
+		return false;
+
+	IncreaseRowProgress(shard, *row, handle, increase);
+	return true;
+}
+
+int32 FAchievementServerPlayerStore::IncreaseProgressForPlayers(const TConstArrayView<FUniqueNetIdRepl> playerIds, const FAchievementHandle handle, const float increase)
+{
+	// group the players per shard first, so every shard is locked once instead of once per player
+	TArray<int32> playersPerShard[NumShards];
+	for (int32 index = 0; index < playerIds.Num(); ++index)
+	{
+		playersPerShard[GetShardIndex(playerIds[index])].Add(index);
+	}
+
+	std::atomic<int32> appliedCount{0};
+	std::atomic<bool> bWasInactive{false};
+	// shards don't share anything, small updates aren't worth waking other threads for
+	ParallelFor(NumShards, [&](const int32 shardIndex)
+	{
+		if (playersPerShard[shardIndex].Num() == 0)
+			return;
+
+		FShard& shard = m_shards[shardIndex];
+		FScopeLock scopeLock(&shard.lock);
+		if (!shard.progress.IsLive(handle.GetIndex()))
+		{
+			bWasInactive.store(true, std::memory_order_relaxed);
+			return;
+		}
+		for (const int32 index : playersPerShard[shardIndex])
+		{
+			if (const int32* row = shard.rowByPlayer.Find(playerIds[index]))
+			{
+				IncreaseRowProgress(shard, *row, handle, increase);
+				appliedCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}, playerIds.Num() < 64 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+	// once for the whole call, not per shard
+	if (bWasInactive.load(std::memory_order_relaxed))
+	{
+		LogInactive(handle);
+	}
+
+	return appliedCount.load(std::memory_order_relaxed);
+}
+
+bool FAchievementServerPlayerStore::GetProgress(const FUniqueNetIdRepl& playerId, const FAchievementHandle handle, FAchievementProgress& outProgress) const
+{
+	const FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+
+	const int32* row = shard.rowByPlayer.Find(playerId);
+	if (!row)
+		return false;
+
+	outProgress = shard.progress.GetProgressStruct(*row, handle.GetIndex());
+	return true;
+}
+
+bool FAchievementServerPlayerStore::ExportPlayer(const FUniqueNetIdRepl& playerId, FAchievementProgressStore& outStore) const
+{
+	const FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+
+	const int32* row = shard.rowByPlayer.Find(playerId);
+	if (!row)
+		return false;
+
+	shard.progress.Export(*row, outStore);
+	return true;
+}
+
+bool FAchievementServerPlayerStore::MergePlayer(const FUniqueNetIdRepl& playerId, const FAchievementProgressStore& store)
+{
+	FShard& shard = m_shards[GetShardIndex(playerId)];
+	FScopeLock scopeLock(&shard.lock);
+
+	const int32* row = shard.rowByPlayer.Find(playerId);
+	if (!row)
+		return false;
+
+	shard.progress.Merge(*row, *m_registry, store);
+	shard.loadedRows[*row] = true;
+
+	// achievements added since the save was written can already be satisfied by it
+	shard.unlockedScratch.Reset();
+	shard.progress.RefreshComposites(*row, *m_registry, shard.unlockedScratch);
+	for (const int32 registryIndex : shard.unlockedScratch)
+	{
+		shard.unlocks.Emplace(playerId, FAchievementHandle(registryIndex));
+	}
+	return true;
+}
+
+void FAchievementServerPlayerStore::CollectDirtyPlayers(TArray<FUniqueNetIdRepl>& outPlayerIds)
+{
+	for (FShard& shard : m_shards)
+	{
+		FScopeLock scopeLock(&shard.lock);
+		for (int32 row = 0; row < shard.playerIds.Num(); ++row)
+		{
+			if (!shard.dirtyRows[row] || !shard.loadedRows[row])
+				continue;
+
+			outPlayerIds.Add(shard.playerIds[row]);
+			shard.dirtyRows[row] = false;
+		}
+	}
+}
+
+void FAchievementServerPlayerStore::CollectUnlocks(TArray<TPair<FUniqueNetIdRepl, FAchievementHandle>>& outUnlocks)
+{
+	for (FShard& shard : m_shards)
+	{
+		FScopeLock scopeLock(&shard.lock);
+		outUnlocks.Append(shard.unlocks);
+		shard.unlocks.Reset();
+	}
+}
+
+void FAchievementServerPlayerStore::LogInactive(const FAchievementHandle handle) const
+{
+	// the ID and set don't change when a set starts or ends, only when the registry gets rebuilt
+	const FAchievementRegistryEntry& entry = m_registry->GetEntry(handle);
+	UE_LOG(AchievementLog, Error, TEXT("Achievement '%s' is part of set '%s' which isn't active"), *entry.achievementId.ToString(), *entry.achievementSet.ToString());
+}
+
+void FAchievementServerPlayerStore::IncreaseRowProgress(FShard& shard, const int32 row, const FAchievementHandle handle, const float increase) const
+{
+	// unlocked achievements don't change anymore, no need to save the player for them
+	if (shard.progress.IsUnlocked(row, handle.GetIndex()))
+		return;
+
+	shard.unlockedScratch.Reset();
+	shard.progress.IncreaseProgress(row, *m_registry, handle.GetIndex(), increase, shard.unlockedScratch);
+	shard.dirtyRows[row] = true;
+
+	for (const int32 registryIndex : shard.unlockedScratch)
+	{
+		shard.unlocks.Emplace(shard.playerIds[row], FAchievementHandle(registryIndex));
+	}
+}
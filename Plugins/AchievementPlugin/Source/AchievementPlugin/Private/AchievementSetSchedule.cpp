@@ -0,0 +1,61 @@
+#include "AchievementSetSchedule.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementRegistry.h"
+#include "AchievementStructs.h"
+
+void FAchievementSetSchedule::Build(const TMap<FString, FAchievementSetData>& achievementSets, const FDateTime& nowUtc)
+{
+	Empty();
+
+	for (const auto& setPair : achievementSets)
+	{
+		const FName setId(*setPair.Key);
+		const FAchievementSetData& set = setPair.Value;
+		m_knownSets.Add(setId);
+		if (set.IsActiveAt(nowUtc))
+		{
+			m_activeSets.Add(setId);
+		}
+
+		// only the boundaries still ahead of us can change anything
+		if (set.startTimeUtc.GetTicks() != 0 && set.startTimeUtc > nowUtc)
+		{
+			m_nextChangeUtc = FMath::Min(m_nextChangeUtc, set.startTimeUtc);
+		}
+		if (set.endTimeUtc.GetTicks() != 0 && set.endTimeUtc > nowUtc)
+		{
+			m_nextChangeUtc = FMath::Min(m_nextChangeUtc, set.endTimeUtc);
+		}
+	}
+}
+
+void FAchievementSetSchedule::Empty()
+{
+	m_activeSets.Reset();
+	m_knownSets.Reset();
+	m_nextChangeUtc = FDateTime::MaxValue();
+}
+
+int32 FAchievementSetSchedule::BuildLiveBits(const FAchievementRegistry& registry, TBitArray<>& outIsLive) const
+{
+	outIsLive.Init(true, registry.Num());
+
+	int32 inactiveCount = 0;
+	for (int32 registryIndex = 0; registryIndex < registry.Num(); ++registryIndex)
+	{
+		const FAchievementRegistryEntry& entry = registry.GetEntry(FAchievementHandle(registryIndex));
+		if (entry.achievementSet.IsNone() || m_activeSets.Contains(entry.achievementSet))
+			continue;
+
+		if (m_knownSets.Contains(entry.achievementSet))
+		{
+			outIsLive[registryIndex] = false;
+			++inactiveCount;
+			continue;
+		}
+		UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' is part of set '%s' which does not exist, it is always available"),
+			   *entry.achievementId.ToString(), *entry.achievementSet.ToString());
+	}
+	return inactiveCount;
+}
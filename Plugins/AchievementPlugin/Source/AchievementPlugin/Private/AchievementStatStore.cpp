@@ -0,0 +1,68 @@
+#include "AchievementStatStore.h"
+
+int32 FAchievementStatStore::FindOrAdd(const FName statId, bool* bOutWasAdded)
+{
+	if (const int32* existing = m_indexByStatId.Find(statId))
+	{
+		if (bOutWasAdded)
+			*bOutWasAdded = false;
+		return *existing;
+	}
+
+	const int32 index = m_statIds.Add(statId);
+	m_values.Add(0.0);
+	m_durations.Add(0.0);
+	m_indexByStatId.Add(statId, index);
+
+	if (bOutWasAdded)
+		*bOutWasAdded = true;
+	return index;
+}
+
+void FAchievementStatStore::Reset(const int32 index)
+{
+	m_values[index] = 0.0;
+	m_durations[index] = 0.0;
+}
+
+void FAchievementStatStore::Empty()
+{
+	m_statIds.Empty();
+	m_values.Empty();
+	m_durations.Empty();
+	m_indexByStatId.Empty();
+}
+
+int32 FAchievementStatStore::RemoveAll(const TFunctionRef<bool(FName statId)> predicate)
+{
+	// compact all columns in a single pass, keeping the order of the remaining entries
+	int32 writeIndex = 0;
+	for (int32 readIndex = 0; readIndex < m_statIds.Num(); ++readIndex)
+	{
+		if (predicate(m_statIds[readIndex]))
+			continue;
+
+		if (writeIndex != readIndex)
+		{
+			m_statIds[writeIndex] = m_statIds[readIndex];
+			m_values[writeIndex] = m_values[readIndex];
+			m_durations[writeIndex] = m_durations[readIndex];
+		}
+		++writeIndex;
+	}
+
+	const int32 removedCount = m_statIds.Num() - writeIndex;
+	if (removedCount > 0)
+	{
+		m_statIds.SetNum(writeIndex);
+		m_values.SetNum(writeIndex);
+		m_durations.SetNum(writeIndex);
+
+		m_indexByStatId.Reset();
+		for (int32 index = 0; index < m_statIds.Num(); ++index)
+		{
+			m_indexByStatId.Add(m_statIds[index], index);
+		}
+	}
+	return removedCount;
+}
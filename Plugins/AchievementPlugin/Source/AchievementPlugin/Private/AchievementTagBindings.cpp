@@ -0,0 +1,86 @@
+#include "AchievementTagBindings.h"
+
+#include "GameplayTagsManager.h"
+#include "AchievementLogCategory.h"
+#include "AchievementRegistry.h"
+#include "AchievementConditions.h"
+#include "AchievementStructs.h"
+
+void FAchievementTagBindings::Build(const FAchievementRegistry& registry, const FAchievementConditions& conditions, const TMap<FString, FAchievementData>& achievementsData)
+{
+	Empty();
+
+	TArray<FGameplayTag> queriedTags;
+	for (const auto& achievementPair : achievementsData)
+	{
+		const FGameplayTagQuery& query = achievementPair.Value.eventQuery;
+		if (query.IsEmpty())
+			continue;
+
+		const FAchievementHandle handle = registry.FindHandle(achievementPair.Key);
+		if (!handle.IsValid())
+			continue;
+
+		// these get their progress somewhere else
+		const FAchievementRegistryEntry& entry = registry.GetEntry(handle);
+		if (entry.statIndex != INDEX_NONE || entry.IsComposite() || conditions.FindCondition(handle.GetIndex()) != INDEX_NONE)
+		{
+			UE_LOG(AchievementLog, Warning, TEXT("Achievement '%s' watches a stat, has dependencies or an unlock condition, its gameplay event query is ignored"), *achievementPair.Key);
+			continue;
+		}
+
+		m_queries.Emplace(handle.GetIndex(), query);
+		for (const FGameplayTag& tag : query.GetGameplayTagArray())
+		{
+			queriedTags.AddUnique(tag);
+		}
+	}
+
+	// events are usually reported with the queried tag or one of its children (Event.Kill.Boss for Event.Kill)
+	const UGameplayTagsManager& tagsManager = UGameplayTagsManager::Get();
+	for (const FGameplayTag& tag : queriedTags)
+	{
+		Find(tag);
+		for (const FGameplayTag& childTag : tagsManager.RequestGameplayTagChildren(tag))
+		{
+			Find(childTag);
+		}
+	}
+
+	UE_LOG(AchievementLog, Log, TEXT("Bound %d achievements to gameplay events, precomputed %d tags"), m_queries.Num(), m_rangeByTag.Num());
+}
+
+void FAchievementTagBindings::Empty()
+{
+	m_queries.Reset();
+	m_rangeByTag.Reset();
+	m_boundAchievements.Reset();
+}
+
+TConstArrayView<int32> FAchievementTagBindings::Find(const FGameplayTag tag)
+{
+	if (const TPair<int32, int32>* range = m_rangeByTag.Find(tag))
+	{
+		return TConstArrayView<int32>(m_boundAchievements.GetData() + range->Key, range->Value);
+	}
+	return Compile(tag);
+}
+
+TConstArrayView<int32> FAchievementTagBindings::Compile(const FGameplayTag tag)
+{
+	// a single tag container also matches queries on its parent tags
+	const FGameplayTagContainer eventTags(tag);
+
+	const int32 start = m_boundAchievements.Num();
+	for (const TPair<int32, FGameplayTagQuery>& query : m_queries)
+	{
+		if (query.Value.Matches(eventTags))
+		{
+			m_boundAchievements.Add(query.Key);
+		}
+	}
+
+	const int32 count = m_boundAchievements.Num() - start;
+	m_rangeByTag.Add(tag, TPair<int32, int32>(start, count));
+	return TConstArrayView<int32>(m_boundAchievements.GetData() + start, count);
+}
@@ -0,0 +1,114 @@
+#include "AchievementTransaction.h"
+
+#include "AchievementLogCategory.h"
+#include "AchievementPlugin.h"
+
+FAchievementTransaction::FAchievementTransaction()
+	: FAchievementTransaction(UAchievementManagerSubSystem::Get())
+{
+}
+
+FAchievementTransaction::FAchievementTransaction(UAchievementManagerSubSystem* manager)
+	: m_manager(manager)
+{
+}
+
+FAchievementTransaction::~FAchievementTransaction()
+{
+	if (m_bIsOpen && (m_progressChanges.Num() > 0 || m_statChanges.Num() > 0))
+	{
+		ACHIEVEMENT_LOG_VERBOSE(AchievementLog, Log, TEXT("Achievement transaction went out of scope without Commit, discarded %d changes"),
+								m_progressChanges.Num() + m_statChanges.Num());
+	}
+}
+
+bool FAchievementTransaction::IncreaseProgress(const FAchievementHandle handle, const float increase)
+{
+	if (!m_bIsOpen || !m_manager.IsValid())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement transaction is already closed"));
+		return false;
+	}
+
+	// same checks the subsystem does, but before anything gets applied
+	if (!m_manager->CanChangeProgress(handle))
+		return false;
+
+	// a handful of changes per event, searching is cheaper than hashing
+	for (FAchievementProgressChange& change : m_progressChanges)
+	{
+		if (change.handle == handle)
+		{
+			change.change += increase;
+			return true;
+		}
+	}
+	m_progressChanges.Emplace(handle, increase);
+	return true;
+}
+
+bool FAchievementTransaction::IncreaseStat(const FAchievementStatHandle handle, const double increase)
+{
+	if (!CanChangeStat(handle))
+		return false;
+
+	// adding to a set keeps it a set, the increase happens after it
+	FindOrAddStatChange(handle).value += increase;
+	return true;
+}
+
+bool FAchievementTransaction::SetStat(const FAchievementStatHandle handle, const double value)
+{
+	if (!CanChangeStat(handle))
+		return false;
+
+	// replaces anything added before
+	FAchievementTransactionStatChange& change = FindOrAddStatChange(handle);
+	change.value = value;
+	change.bIsSet = true;
+	return true;
+}
+
+int32 FAchievementTransaction::Commit()
+{
+	if (!m_bIsOpen || !m_manager.IsValid())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement transaction is already closed"));
+		return 0;
+	}
+	m_bIsOpen = false;
+
+	return m_manager->CommitTransaction(m_progressChanges, m_statChanges);
+}
+
+void FAchievementTransaction::Abort()
+{
+	m_bIsOpen = false;
+	m_progressChanges.Reset();
+	m_statChanges.Reset();
+}
+
+bool FAchievementTransaction::CanChangeStat(const FAchievementStatHandle handle) const
+{
+	if (!m_bIsOpen || !m_manager.IsValid())
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement transaction is already closed"));
+		return false;
+	}
+	return m_manager->CanChangeStat(handle);
+}
+
+FAchievementTransactionStatChange& FAchievementTransaction::FindOrAddStatChange(const FAchievementStatHandle handle)
+{
+	for (FAchievementTransactionStatChange& change : m_statChanges)
+	{
+		if (change.handle == handle)
+		{
+			return change;
+		}
+	}
+
+	FAchievementTransactionStatChange& change = m_statChanges.AddDefaulted_GetRef();
+	change.handle = handle;
+	return change;
+}
@@ -0,0 +1,102 @@
+#include "AchievementWindowedCounters.h"
+
+#include "AchievementRegistry.h"
+
+void FAchievementWindowedCounters::Build(const FAchievementRegistry& registry)
+{
+	m_windows.Reset();
+	m_windows.Reserve(registry.NumWindows());
+
+	int32 bucketTotal = 0;
+	for (const int32 registryIndex : registry.GetWindowedAchievements())
+	{
+		const FAchievementWindowSettings& settings = registry.GetEntry(FAchievementHandle(registryIndex)).window;
+
+		FWindow& window = m_windows.AddDefaulted_GetRef();
+		window.firstBucket = bucketTotal;
+		window.scope = settings.resetScope;
+		window.generation = GetScopeGeneration(settings.resetScope);
+		if (settings.windowSeconds > 0.f)
+		{
+			window.bucketCount = FMath::Clamp(settings.bucketCount, 1, 64);
+			window.bucketSeconds = static_cast<double>(settings.windowSeconds) / window.bucketCount;
+		}
+		bucketTotal += window.bucketCount;
+	}
+
+	// one allocation for every window, the memory only depends on the settings
+	m_buckets.Init(0.f, bucketTotal);
+}
+
+float FAchievementWindowedCounters::Add(const int32 windowIndex, const float amount, const double currentTime)
+{
+	Advance(windowIndex, currentTime);
+
+	FWindow& window = m_windows[windowIndex];
+	m_buckets[window.firstBucket + window.headBucket] += amount;
+	window.total += amount;
+	return window.total;
+}
+
+float FAchievementWindowedCounters::Advance(const int32 windowIndex, const double currentTime)
+{
+	ClearIfStale(windowIndex, currentTime);
+
+	FWindow& window = m_windows[windowIndex];
+	if (window.bucketSeconds <= 0.0)
+		return window.total;
+
+	const int64 elapsedBuckets = FMath::FloorToInt64((currentTime - window.headStartTime) / window.bucketSeconds);
+	if (elapsedBuckets <= 0)
+		return window.total;
+
+	if (elapsedBuckets >= window.bucketCount)
+	{
+		// everything expired, no need to walk the ring
+		Reset(windowIndex);
+		window.headStartTime = currentTime;
+		return 0.f;
+	}
+
+	// expire the buckets the head moves over, they hold the oldest progress
+	for (int64 step = 0; step < elapsedBuckets; ++step)
+	{
+		window.headBucket = (window.headBucket + 1) % window.bucketCount;
+		float& bucket = m_buckets[window.firstBucket + window.headBucket];
+		window.total -= bucket;
+		bucket = 0.f;
+	}
+	window.headStartTime += elapsedBuckets * window.bucketSeconds;
+
+	// summing and subtracting floats can drift slightly below 0
+	window.total = FMath::Max(window.total, 0.f);
+	return window.total;
+}
+
+void FAchievementWindowedCounters::ResetScope(const EAchievementScope scope)
+{
+	if (scope == EAchievementScope::Persistent)
+		return;
+
+	// the windows notice the new generation in ClearIfStale, nothing is touched here
+	++m_scopeGenerations[static_cast<int32>(scope)];
+}
+
+void FAchievementWindowedCounters::ClearIfStale(const int32 windowIndex, const double currentTime)
+{
+	FWindow& window = m_windows[windowIndex];
+	if (!IsStale(window))
+		return;
+
+	Reset(windowIndex);
+	window.headStartTime = currentTime;
+	window.generation = GetScopeGeneration(window.scope);
+}
+
+void FAchievementWindowedCounters::Reset(const int32 windowIndex)
+{
+	FWindow& window = m_windows[windowIndex];
+	FMemory::Memzero(m_buckets.GetData() + window.firstBucket, window.bucketCount * sizeof(float));
+	window.headBucket = 0;
+	window.total = 0.f;
+}
@@ -141,7 +141,7 @@ TMap<FString, FAchievementData> SteamAchievementsClass::GetSteamAchievementsAsAc
 	return achievementsData;
 }
 
-bool SteamAchievementsClass::SetSteamAchievementProgress(const FAchievementPlatformData& achievementData, const float progress, const bool unlocked)
+bool SteamAchievementsClass::SetSteamAchievementProgress(const FAchievementPlatformData& achievementData, const float progress, const bool unlocked, const bool bStoreImmediately)
 {
 	if (GetPlatformInitialized())
 	{
@@ -151,7 +151,7 @@ bool SteamAchievementsClass::SetSteamAchievementProgress(const FAchievementPlatf
 		{
 			// Unlock any achievement (works for both one-time and incremental)
 			bSuccess = SteamUserStats()->SetAchievement(TCHAR_TO_ANSI(*achievementData.steamAchievementID));
-			UE_LOG(AchievementPlatformLog, Log, TEXT("Telling Steam to unlock: %s"), *achievementData.steamAchievementID);
+			ACHIEVEMENT_LOG_VERBOSE(AchievementPlatformLog, Log, TEXT("Telling Steam to unlock: %s"), *achievementData.steamAchievementID);
 		}
 		else
 		{
@@ -182,8 +182,10 @@ bool SteamAchievementsClass::SetSteamAchievementProgress(const FAchievementPlatf
 		// Store changes to Steam
 		if (bSuccess)
 		{
-			UE_LOG(AchievementPlatformLog, Log, TEXT("Telling Steam to update achievement stat: %s = %f"), *achievementData.steamAchievementID, progress);
-			SteamUserStats()->StoreStats();
+			ACHIEVEMENT_LOG_VERBOSE(AchievementPlatformLog, Log, TEXT("Telling Steam to update achievement stat: %s = %f"), *achievementData.steamAchievementID, progress);
+			// batched updates store everything at once afterwards
+			if (bStoreImmediately)
+				SteamUserStats()->StoreStats();
 		}
 		else
 			UE_LOG(AchievementPlatformLog, Error, TEXT("ERROR, SetStat/SetAchievevement returned false, could not update StoreStats()"));
@@ -194,6 +196,81 @@ bool SteamAchievementsClass::SetSteamAchievementProgress(const FAchievementPlatf
 	return false;
 }
 
+bool SteamAchievementsClass::SetSteamStat(const FAchievementStatPlatformData& statData, const EAchievementStatType type, const double value, const bool bStoreImmediately)
+{
+	if (GetPlatformInitialized())
+	{
+		if (statData.steamStatID.IsEmpty())
+			return true;
+
+		bool bSuccess = false;
+		switch (type)
+		{
+			case EAchievementStatType::Int:
+			{
+				bSuccess = SteamUserStats()->SetStat(TCHAR_TO_ANSI(*statData.steamStatID), static_cast<int32>(value));
+				break;
+			}
+			case EAchievementStatType::Float:
+			{
+				bSuccess = SteamUserStats()->SetStat(TCHAR_TO_ANSI(*statData.steamStatID), static_cast<float>(value));
+				break;
+			}
+			default:
+			{
+				UE_LOG(AchievementPlatformLog, Error, TEXT("Average rate stat '%s' has to be updated with UpdateSteamAverageRateStat"), *statData.steamStatID);
+				return false;
+			}
+		}
+
+		if (bSuccess)
+		{
+			ACHIEVEMENT_LOG_VERBOSE(AchievementPlatformLog, Log, TEXT("Telling Steam to update stat: %s = %f"), *statData.steamStatID, value);
+			if (bStoreImmediately)
+				SteamUserStats()->StoreStats();
+		}
+		else
+			UE_LOG(AchievementPlatformLog, Error, TEXT("ERROR, SetStat returned false for '%s'"), *statData.steamStatID);
+
+		return bSuccess;
+	}
+	UE_LOG(AchievementPlatformLog, Error, TEXT("ERROR: Steam API wasn't initialized properly!"));
+	return false;
+}
+
+bool SteamAchievementsClass::UpdateSteamAverageRateStat(const FAchievementStatPlatformData& statData, const double count, const double seconds, const bool bStoreImmediately)
+{
+	if (GetPlatformInitialized())
+	{
+		if (statData.steamStatID.IsEmpty())
+			return true;
+
+		const bool bSuccess = SteamUserStats()->UpdateAvgRateStat(TCHAR_TO_ANSI(*statData.steamStatID), static_cast<float>(count), seconds);
+		if (bSuccess)
+		{
+			ACHIEVEMENT_LOG_VERBOSE(AchievementPlatformLog, Log, TEXT("Telling Steam to update average rate stat: %s += %f over %fs"), *statData.steamStatID, count, seconds);
+			if (bStoreImmediately)
+				SteamUserStats()->StoreStats();
+		}
+		else
+			UE_LOG(AchievementPlatformLog, Error, TEXT("ERROR, UpdateAvgRateStat returned false for '%s'"), *statData.steamStatID);
+
+		return bSuccess;
+	}
+	UE_LOG(AchievementPlatformLog, Error, TEXT("ERROR: Steam API wasn't initialized properly!"));
+	return false;
+}
+
+bool SteamAchievementsClass::StoreSteamStats()
+{
+	if (GetPlatformInitialized())
+	{
+		return SteamUserStats()->StoreStats();
+	}
+	UE_LOG(AchievementPlatformLog, Error, TEXT("ERROR: Steam API wasn't initialized properly!"));
+	return false;
+}
+
 bool SteamAchievementsClass::DeleteSteamAchievementProgress(const FAchievementPlatformData& achievementData)
 {
 	const auto& name = achievementData.steamAchievementID;
@@ -276,7 +353,7 @@ void SteamCallbacksClass::OnUserStatsStored(UserStatsStored_t* pCallback)
 	{
 		if (pCallback->m_eResult == k_EResultOK)
 		{
-			UE_LOG(AchievementPlatformLog, Log, TEXT("User stats stored successfully!"));
+			ACHIEVEMENT_LOG_VERBOSE(AchievementPlatformLog, Log, TEXT("User stats stored successfully!"));
 		}
 		else
 		{
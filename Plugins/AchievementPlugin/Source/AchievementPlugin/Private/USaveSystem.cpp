@@ -1,9 +1,102 @@
 #include "USaveSystem.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/Paths.h"
 #include "AchievementLogCategory.h"
 #include "AchievementPlugin.h"
 
-bool UAchievementSaveManager::SaveProgressAsync(const TMap<int32, FAchievementProgress>& achievements)
+void UAchievementSave::SetData(const FAchievementProgressStore& inData)
+{
+	saveVersion = CurrentSaveVersion;
+	linkIDs = inData.GetLinkIDs();
+	unlockedTicks = inData.GetUnlockedTicksValues();
+
+	// windowed/scoped totals are never written, they start over in every session
+	progress.SetNumUninitialized(inData.Num());
+	unlocked.SetNumUninitialized(inData.Num());
+	for (int32 index = 0; index < inData.Num(); ++index)
+	{
+		progress[index] = inData.GetSavedProgress(index);
+		unlocked[index] = inData.IsUnlocked(index);
+	}
+}
+
+void UAchievementSave::GetData(FAchievementProgressStore& outData) const
+{
+	outData.Empty();
+
+	if (saveVersion == LegacySaveVersion)
+	{
+		// old saves stored the unlock time as a formatted local time string (or "Never"), turn it into UTC ticks
+		// Note: this uses the current UTC offset, so unlocks from a different daylight saving period can be an hour off
+		const FTimespan utcOffset = FDateTime::Now() - FDateTime::UtcNow();
+		for (const auto& progressPair : achievementProgressSave)
+		{
+			FAchievementProgress migratedProgress = progressPair.Value;
+
+			FDateTime localUnlockTime;
+			if (FDateTime::Parse(migratedProgress.unlockedTime_DEPRECATED, localUnlockTime))
+			{
+				migratedProgress.unlockedTicks = (localUnlockTime - utcOffset).GetTicks();
+			}
+			else if (migratedProgress.bIsAchievementUnlocked)
+			{
+				// unlocked but the time got lost, better to show it as unlocked now than never
+				migratedProgress.unlockedTicks = FDateTime::UtcNow().GetTicks();
+			}
+			migratedProgress.unlockedTime_DEPRECATED.Empty();
+
+			outData.SetProgressStruct(outData.FindOrAdd(progressPair.Key), migratedProgress);
+		}
+
+		UE_LOG(AchievementLog, Log, TEXT("Migrated %d achievement progress entries from a legacy save"), achievementProgressSave.Num());
+		return;
+	}
+
+	const int32 count = linkIDs.Num();
+	if (progress.Num() != count || unlocked.Num() != count || unlockedTicks.Num() != count)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement save is corrupted, column sizes do not match!"));
+		return;
+	}
+
+	for (int32 index = 0; index < count; ++index)
+	{
+		const int32 storeIndex = outData.FindOrAdd(linkIDs[index]);
+		outData.SetProgress(storeIndex, progress[index]);
+		if (unlocked[index])
+		{
+			outData.Unlock(storeIndex, unlockedTicks[index]);
+		}
+	}
+}
+
+void UAchievementSave::SetStats(const FAchievementStatStore& inStats)
+{
+	statIds = inStats.GetStatIds();
+	statValues = inStats.GetValues();
+	statDurations = inStats.GetDurations();
+}
+
+void UAchievementSave::GetStats(FAchievementStatStore& outStats) const
+{
+	outStats.Empty();
+
+	const int32 count = statIds.Num();
+	if (statValues.Num() != count || statDurations.Num() != count)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Achievement save is corrupted, stat column sizes do not match!"));
+		return;
+	}
+
+	for (int32 index = 0; index < count; ++index)
+	{
+		const int32 storeIndex = outStats.FindOrAdd(statIds[index]);
+		outStats.SetValue(storeIndex, statValues[index]);
+		outStats.SetDuration(storeIndex, statDurations[index]);
+	}
+}
+
+bool UAchievementSaveManager::SaveProgressAsync(const FAchievementProgressStore& achievements, const FAchievementStatStore& stats)
 {
 	if (m_bIsSaving == true)
 	{
@@ -15,6 +108,7 @@ bool UAchievementSaveManager::SaveProgressAsync(const TMap<int32, FAchievementPr
 
 	UAchievementSave* saveGameInstance = NewObject<UAchievementSave>();
 	saveGameInstance->SetData(achievements);
+	saveGameInstance->SetStats(stats);
 
 	// Save asynchronously
 	UGameplayStatics::AsyncSaveGameToSlot(
@@ -27,7 +121,7 @@ bool UAchievementSaveManager::SaveProgressAsync(const TMap<int32, FAchievementPr
 	return true;
 }
 
-bool UAchievementSaveManager::SaveProgress(const TMap<int32, FAchievementProgress>& achievements) const
+bool UAchievementSaveManager::SaveProgress(const FAchievementProgressStore& achievements, const FAchievementStatStore& stats) const
 {
 	if (m_bIsSaving)
 	{
@@ -37,6 +131,7 @@ bool UAchievementSaveManager::SaveProgress(const TMap<int32, FAchievementProgres
 
 	UAchievementSave* saveGameInstance = NewObject<UAchievementSave>();
 	saveGameInstance->SetData(achievements);
+	saveGameInstance->SetStats(stats);
 	// Use synchronous save
 	const bool bSaveSuccess = UGameplayStatics::SaveGameToSlot(saveGameInstance, m_saveSlotSettings.slotName, m_saveSlotSettings.slotIndex);
 
@@ -53,15 +148,16 @@ bool UAchievementSaveManager::SaveProgress(const TMap<int32, FAchievementProgres
 	return bSaveSuccess;
 }
 
-TMap<int32, FAchievementProgress> UAchievementSaveManager::LoadProgress() const
+bool UAchievementSaveManager::LoadProgress(FAchievementProgressStore& outAchievements, FAchievementStatStore& outStats) const
 {
-	TMap<int32, FAchievementProgress> loadedAchievements = TMap<int32, FAchievementProgress>();
+	outAchievements.Empty();
+	outStats.Empty();
 
 	// Check if save file exists first
 	if (!UGameplayStatics::DoesSaveGameExist(m_saveSlotSettings.slotName, m_saveSlotSettings.slotIndex))
 	{
 		UE_LOG(AchievementLog, Warning, TEXT("Save file doesn't exist: %s (User %d)"), *m_saveSlotSettings.slotName, m_saveSlotSettings.slotIndex);
-		return loadedAchievements;
+		return false;
 	}
 	// Load the save game (casting is required here)
 	const UAchievementSave* loadedSave = Cast<UAchievementSave>(UGameplayStatics::LoadGameFromSlot(m_saveSlotSettings.slotName, m_saveSlotSettings.slotIndex));
@@ -69,15 +165,123 @@ TMap<int32, FAchievementProgress> UAchievementSaveManager::LoadProgress() const
 	if (!loadedSave)
 	{
 		UE_LOG(AchievementLog, Error, TEXT("Loaded save game is not of type USaveAchievement"));
-		return loadedAchievements;
+		return false;
 	}
 
 	// copy over the loaded achievementsData
-	loadedAchievements = loadedSave->achievementProgressSave;
+	loadedSave->GetData(outAchievements);
+	loadedSave->GetStats(outStats);
+
+	UE_LOG(AchievementLog, Log, TEXT("Successfully loaded %d achievementProgress and %d stats"), outAchievements.Num(), outStats.Num());
+
+	return true;
+}
+
+bool UAchievementSaveManager::SaveLocalUserProgress(const FAchievementProgressStore& achievements, const int32 localUserIndex) const
+{
+	UAchievementSave* saveGameInstance = NewObject<UAchievementSave>();
+	saveGameInstance->SetData(achievements);
+
+	const FString slotName = GetLocalUserSlotName(localUserIndex);
+	const bool bSaveSuccess = UGameplayStatics::SaveGameToSlot(saveGameInstance, slotName, localUserIndex);
+	if (bSaveSuccess)
+	{
+		UE_LOG(AchievementLog, Log, TEXT("Saved %d achievementsData to '%s' for local user %d"), achievements.Num(), *slotName, localUserIndex);
+	}
+	else
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Failed to save achievementsData to slot '%s' for local user %d"), *slotName, localUserIndex);
+	}
+	return bSaveSuccess;
+}
+
+bool UAchievementSaveManager::LoadLocalUserProgress(FAchievementProgressStore& outAchievements, const int32 localUserIndex) const
+{
+	outAchievements.Empty();
+
+	const FString slotName = GetLocalUserSlotName(localUserIndex);
+	if (!UGameplayStatics::DoesSaveGameExist(slotName, localUserIndex))
+	{
+		UE_LOG(AchievementLog, Log, TEXT("No save for local user %d yet (%s)"), localUserIndex, *slotName);
+		return false;
+	}
+
+	const UAchievementSave* loadedSave = Cast<UAchievementSave>(UGameplayStatics::LoadGameFromSlot(slotName, localUserIndex));
+	if (!loadedSave)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Loaded save game for local user %d is not of type USaveAchievement"), localUserIndex);
+		return false;
+	}
+
+	loadedSave->GetData(outAchievements);
+	UE_LOG(AchievementLog, Log, TEXT("Successfully loaded %d achievementProgress for local user %d"), outAchievements.Num(), localUserIndex);
+	return true;
+}
+
+bool UAchievementSaveManager::SavePlayerProgressAsync(const FAchievementProgressStore& achievements, const FUniqueNetIdRepl& playerId)
+{
+	UAchievementSave* saveGameInstance = NewObject<UAchievementSave>();
+	saveGameInstance->SetData(achievements);
+
+	UGameplayStatics::AsyncSaveGameToSlot(
+		saveGameInstance,
+		GetPlayerSlotName(playerId),
+		0,
+		FAsyncSaveGameToSlotDelegate::CreateWeakLambda(this, [](const FString& slotName, const int32, const bool bSuccess)
+		{
+			// saves succeed hundreds of times per match on a server, only failures are worth a line
+			if (!bSuccess)
+				UE_LOG(AchievementLog, Error, TEXT("Failed to save player achievement progress to slot '%s'"), *slotName);
+		})
+	);
+	return true;
+}
 
-	UE_LOG(AchievementLog, Log, TEXT("Successfully loaded %d achievementProgress"), loadedAchievements.Num());
+bool UAchievementSaveManager::SavePlayerProgress(const FAchievementProgressStore& achievements, const FUniqueNetIdRepl& playerId) const
+{
+	UAchievementSave* saveGameInstance = NewObject<UAchievementSave>();
+	saveGameInstance->SetData(achievements);
 
-	return loadedAchievements;
+	const FString slotName = GetPlayerSlotName(playerId);
+	const bool bSaveSuccess = UGameplayStatics::SaveGameToSlot(saveGameInstance, slotName, 0);
+	if (!bSaveSuccess)
+	{
+		UE_LOG(AchievementLog, Error, TEXT("Failed to save player achievement progress to slot '%s'"), *slotName);
+	}
+	return bSaveSuccess;
+}
+
+void UAchievementSaveManager::LoadPlayerProgressAsync(const FUniqueNetIdRepl& playerId, FOnPlayerProgressLoaded onLoaded)
+{
+	UGameplayStatics::AsyncLoadGameFromSlot(
+		GetPlayerSlotName(playerId),
+		0,
+		FAsyncLoadGameFromSlotDelegate::CreateWeakLambda(this, [playerId, onLoaded](const FString& slotName, const int32, USaveGame* saveGame)
+		{
+			FAchievementProgressStore loadedProgress;
+			if (const UAchievementSave* loadedSave = Cast<UAchievementSave>(saveGame))
+			{
+				loadedSave->GetData(loadedProgress);
+			}
+			else if (saveGame)
+			{
+				UE_LOG(AchievementLog, Error, TEXT("Loaded save game '%s' is not of type USaveAchievement"), *slotName);
+			}
+			onLoaded.ExecuteIfBound(playerId, loadedProgress);
+		})
+	);
+}
+
+FString UAchievementSaveManager::GetPlayerSlotName(const FUniqueNetIdRepl& playerId) const
+{
+	// some online subsystems use characters in their IDs that are not allowed in file names
+	return FPaths::MakeValidFileName(FString::Printf(TEXT("%s_%s"), *m_saveSlotSettings.slotName, *playerId.ToString()), TEXT('_'));
+}
+
+FString UAchievementSaveManager::GetLocalUserSlotName(const int32 localUserIndex) const
+{
+	// most platforms ignore the user index when naming the file, so it has to be part of the slot name
+	return FString::Printf(TEXT("%s_User%d"), *m_saveSlotSettings.slotName, localUserIndex);
 }
 
 void UAchievementSaveManager::SetSaveSlotSettings(const FSaveSlotSettings& newSettings)
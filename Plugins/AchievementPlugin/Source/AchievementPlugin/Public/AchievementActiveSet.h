@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAchievementRegistry;
+class FAchievementProgressStore;
+
+// the achievements that are still locked, indexed by registry index
+// checking one is a single bit test, and the dense list lets passes over the catalog skip everything that is unlocked
+// Note: unlocking is the only way out, rebuild the set whenever progress gets reset or loaded or a set starts or ends
+class ACHIEVEMENTPLUGIN_API FAchievementActiveSet
+{
+public:
+	// every live achievement whose progress isn't unlocked becomes active
+	// the registry has to be bound to the store
+	void Build(const FAchievementRegistry& registry, const FAchievementProgressStore& store);
+
+	bool IsActive(const int32 registryIndex) const
+	{
+		return m_isActive[registryIndex];
+	}
+	// O(1), the last active achievement takes the removed one's place in the list
+	void Remove(int32 registryIndex);
+
+	// registry indices of every locked achievement, unordered
+	TConstArrayView<int32> GetActive() const
+	{
+		return m_active;
+	}
+	int32 Num() const
+	{
+		return m_active.Num();
+	}
+
+private:
+	TBitArray<> m_isActive;
+	TArray<int32> m_active;
+	// where every registry index is inside m_active, INDEX_NONE once it got removed
+	TArray<int32> m_positions;
+};
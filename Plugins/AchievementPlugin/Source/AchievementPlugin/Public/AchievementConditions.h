@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAchievementRegistry;
+struct FAchievementData;
+
+// unlock conditions over stats ("wins >= 10 && deaths == 0"), compiled into postfix bytecode once when the registry is built
+// every condition owns a contiguous range of instructions inside one pool, and every stat knows the conditions reading it
+// so a condition only has to be evaluated again when one of its stats changed
+class ACHIEVEMENTPLUGIN_API FAchievementConditions
+{
+public:
+	// deeper expressions are rejected when compiling, so evaluating never allocates
+	static constexpr int32 MaxStackDepth = 32;
+
+	void Build(const FAchievementRegistry& registry, const TMap<FString, FAchievementData>& achievementsData);
+	void Empty();
+
+	int32 Num() const
+	{
+		return m_conditions.Num();
+	}
+	// INDEX_NONE if the achievement has no condition
+	int32 FindCondition(const int32 registryIndex) const
+	{
+		return m_conditionByAchievement.IsValidIndex(registryIndex) ? m_conditionByAchievement[registryIndex] : INDEX_NONE;
+	}
+	int32 GetAchievementIndex(const int32 conditionIndex) const
+	{
+		return m_conditions[conditionIndex].registryIndex;
+	}
+	// every condition that reads the stat
+	TConstArrayView<int32> GetConditionsForStat(const int32 statIndex) const
+	{
+		const int32 first = m_firstConditionByStat[statIndex];
+		return TConstArrayView<int32>(m_conditionsByStat.GetData() + first, m_firstConditionByStat[statIndex + 1] - first);
+	}
+
+	// getStatValue is called with the stat's registry index
+	bool Evaluate(int32 conditionIndex, TFunctionRef<double(int32 statIndex)> getStatValue) const;
+
+	enum class EOp : uint8
+	{
+		PushConstant,
+		PushStat,
+		Negate,
+		Not,
+		Add,
+		Subtract,
+		Multiply,
+		Divide,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+		Equal,
+		NotEqual,
+		And,
+		Or
+	};
+
+	struct FInstruction
+	{
+		EOp op = EOp::PushConstant;
+		// constant index for PushConstant, stat index for PushStat, unused otherwise
+		int32 operand = 0;
+	};
+
+private:
+	struct FCondition
+	{
+		int32 registryIndex = INDEX_NONE;
+		int32 firstInstruction = 0;
+		int32 instructionCount = 0;
+	};
+
+	TArray<FCondition> m_conditions;
+	TArray<FInstruction> m_instructions;
+	TArray<double> m_constants;
+	TArray<int32> m_conditionByAchievement;
+
+	// conditions grouped per stat, stat i owns [m_firstConditionByStat[i], m_firstConditionByStat[i + 1])
+	TArray<int32> m_conditionsByStat;
+	TArray<int32> m_firstConditionByStat;
+};
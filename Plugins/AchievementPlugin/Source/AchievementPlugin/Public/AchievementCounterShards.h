@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+// per-thread counters for very high-frequency events (bullets fired, footsteps, ...)
+// every thread increments its own shard without contention, the game thread merges all shards at its own cadence
+// counters are indexed by registry index, so up to MaxCounters achievements can be counted
+class ACHIEVEMENTPLUGIN_API FAchievementCounterShards
+{
+public:
+	static constexpr int32 SlotsPerChunk = 256;
+	static constexpr int32 MaxChunks = 128;
+	static constexpr int32 MaxCounters = SlotsPerChunk * MaxChunks;
+
+	FAchievementCounterShards();
+	~FAchievementCounterShards();
+
+	FAchievementCounterShards(const FAchievementCounterShards&) = delete;
+	FAchievementCounterShards& operator=(const FAchievementCounterShards&) = delete;
+
+	// safe to call from any thread, returns false if the index is out of range
+	bool Increment(int32 counterIndex, int64 amount);
+
+	// collects and clears everything counted since the last merge, game thread only
+	// calls mergeFunction once per counter that changed with the summed amount
+	void Merge(TFunctionRef<void(int32 counterIndex, int64 amount)> mergeFunction);
+
+private:
+	struct FChunk
+	{
+		// set by the owning thread whenever one of its slots changes, so merging can skip untouched chunks
+		std::atomic<bool> bDirty{false};
+		std::atomic<int64> slots[SlotsPerChunk];
+
+		FChunk()
+		{
+			for (std::atomic<int64>& slot : slots)
+			{
+				slot.store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	struct FShard
+	{
+		// only the owning thread allocates chunks, the merging thread only reads the pointers
+		std::atomic<FChunk*> chunks[MaxChunks];
+
+		FShard()
+		{
+			for (std::atomic<FChunk*>& chunk : chunks)
+			{
+				chunk.store(nullptr, std::memory_order_relaxed);
+			}
+		}
+		~FShard()
+		{
+			for (std::atomic<FChunk*>& chunk : chunks)
+			{
+				delete chunk.load(std::memory_order_relaxed);
+			}
+		}
+	};
+
+	FShard& GetShardForCurrentThread();
+
+	// unique per instance so cached thread shards can never point at a destroyed instance
+	const uint64 m_instanceId;
+
+	// guards registering new shards, increments never take this lock
+	FCriticalSection m_shardsLock;
+	// Note: shards live until this object is destroyed, threads are expected to be long-lived (task graph, pools)
+	TArray<TUniquePtr<FShard>> m_shards;
+};
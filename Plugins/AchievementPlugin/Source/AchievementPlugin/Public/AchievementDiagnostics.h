@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAchievementRegistry;
+
+// cheap per-achievement counters instead of a log line per event, indexed by registry index
+// printed every Achievements.DiagnosticsInterval seconds or on demand with Achievements.DumpDiagnostics
+// Note: game thread only, like the progress store
+class ACHIEVEMENTPLUGIN_API FAchievementDiagnostics
+{
+public:
+	// amount of achievements listed in a summary
+	static constexpr int32 MaxListedAchievements = 10;
+
+	// clears all counters and sizes them for the registry, call this after rebuilding it
+	void Reset(int32 achievementCount);
+
+	void RecordProgressUpdate(const int32 registryIndex)
+	{
+		++m_progressUpdates[registryIndex];
+		++m_totalProgressUpdates;
+	}
+	void RecordSkippedUnlocked(const int32 registryIndex)
+	{
+		++m_skippedUnlocked[registryIndex];
+		++m_totalSkippedUnlocked;
+	}
+	// progress for an achievement whose set isn't active, rejected rather than skipped
+	void RecordSkippedInactive(const int32 registryIndex)
+	{
+		++m_skippedInactive[registryIndex];
+		++m_totalSkippedInactive;
+	}
+	void RecordUnlock()
+	{
+		++m_totalUnlocks;
+	}
+	void RecordPlatformWrite(const int32 registryIndex)
+	{
+		++m_platformWrites[registryIndex];
+		++m_totalPlatformWrites;
+	}
+	void RecordPlatformStore()
+	{
+		++m_totalPlatformStores;
+	}
+
+	bool HasActivity() const
+	{
+		return m_totalProgressUpdates != 0 || m_totalSkippedUnlocked != 0 || m_totalSkippedInactive != 0 || m_totalPlatformWrites != 0;
+	}
+
+	// logs the totals since the last summary and the busiest achievements, bResetCounters starts a new period afterwards
+	void LogSummary(const FAchievementRegistry& registry, bool bResetCounters);
+
+private:
+	void ClearCounters();
+
+	TArray<uint32> m_progressUpdates;
+	TArray<uint32> m_skippedUnlocked;
+	TArray<uint32> m_skippedInactive;
+	TArray<uint32> m_platformWrites;
+
+	uint64 m_totalProgressUpdates = 0;
+	uint64 m_totalSkippedUnlocked = 0;
+	uint64 m_totalSkippedInactive = 0;
+	uint64 m_totalUnlocks = 0;
+	uint64 m_totalPlatformWrites = 0;
+	uint64 m_totalPlatformStores = 0;
+
+	// start of the current period
+	double m_periodStartSeconds = 0.0;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "AchievementStructs.h"
+
+#include "AchievementIdHeaderGenerator.generated.h"
+
+#if WITH_EDITOR
+// writes AchievementIds.h, a C++ header with a compile-time EAchievementId per achievement in the settings
+// the enum values are the LinkIDs, so resolving them never hashes and removed achievements fail to compile
+class ACHIEVEMENTPLUGIN_API FAchievementIdHeaderGenerator
+{
+public:
+	// the plugin's Public folder, unless the settings override it
+	static FString GetOutputPath();
+
+	// returns false (and fills outError) if the achievements cannot be turned into unique identifiers
+	static bool GenerateHeaderText(const TMap<FString, FAchievementData>& achievementsData, FString& outHeaderText, FString& outError);
+
+	// generates and writes the header, the file is left untouched if nothing changed (so it doesn't trigger rebuilds)
+	static bool WriteHeader(const FString& outputPath);
+};
+#endif
+
+UCLASS()
+// usage: UnrealEditor-Cmd <Project>.uproject -run=GenerateAchievementIds [-output=<path>]
+class UGenerateAchievementIdsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+public:
+	UGenerateAchievementIdsCommandlet();
+
+	virtual int32 Main(const FString& params) override;
+};
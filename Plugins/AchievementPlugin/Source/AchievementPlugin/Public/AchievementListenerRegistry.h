@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementStructs.h"
+
+#include "AchievementListenerRegistry.generated.h"
+
+class FAchievementRegistry;
+
+// called at the end of the frame for a single achievement whose progress changed, the bound object is only weakly referenced
+DECLARE_DYNAMIC_DELEGATE_TwoParams(FOnAchievementProgressUpdated, FAchievementHandle, handle, const FAchievementProgress&, progress);
+
+// subscriptions per achievement, so a change only reaches the listeners of that achievement
+// the lists are indexed by registry index, notifying walks one small contiguous array per changed achievement
+class ACHIEVEMENTPLUGIN_API FAchievementListenerRegistry
+{
+public:
+	// re-keys every subscription after the registry got rebuilt, subscriptions to removed achievements are dropped
+	void Rebind(const FAchievementRegistry& registry);
+	void Empty();
+
+	// returns the id used to unsubscribe
+	int32 Subscribe(FAchievementHandle handle, FName achievementId, const FOnAchievementProgressUpdated& listener);
+	// returns false if the subscription did not exist (anymore)
+	bool Unsubscribe(int32 subscriptionId);
+	// removes every subscription bound to the object, returns the amount removed
+	int32 UnsubscribeAll(const UObject* listenerObject);
+
+	bool HasListeners(const int32 registryIndex) const
+	{
+		return m_listenersByAchievement.IsValidIndex(registryIndex) && m_listenersByAchievement[registryIndex].Num() > 0;
+	}
+	// calls every listener of the achievement, listeners whose object got destroyed are removed on the way
+	void Notify(FAchievementHandle handle, const FAchievementProgress& progress);
+
+private:
+	struct FListener
+	{
+		int32 subscriptionId = INDEX_NONE;
+		FName achievementId;
+		FOnAchievementProgressUpdated delegate;
+	};
+
+	TArray<TArray<FListener>> m_listenersByAchievement;
+	// registry index per subscription, so unsubscribing doesn't have to search every list
+	TMap<int32, int32> m_achievementIndexBySubscription;
+	int32 m_nextSubscriptionId = 1;
+	// unsubscribing while notifying only unbinds, the list gets compacted once notifying is done
+	bool m_bNotifying = false;
+};
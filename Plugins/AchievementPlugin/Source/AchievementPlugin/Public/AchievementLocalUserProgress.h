@@ -0,0 +1,108 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementStructs.h"
+#include "AchievementProgressStore.h"
+
+class FAchievementRegistry;
+
+// progress of the additional local (split-screen) users, all of them held at once in one contiguous block
+// every user owns a row with a column per live achievement, handles find their column through a table shared by all rows
+// achievements of inactive sets have no column, only the progress a user actually made on them is kept (by LinkID)
+// Note: the primary user keeps using the subsystem's FAchievementProgressStore
+// not thread-safe, the subsystem uses it on the game thread and every server shard owns one behind its lock
+class ACHIEVEMENTPLUGIN_API FAchievementLocalUserProgress
+{
+public:
+	// lays the columns out for the registry's live achievements, all progress is cleared (Export the users first to keep it)
+	void Build(const FAchievementRegistry& registry);
+	void Empty();
+
+	// returns INDEX_NONE if the user was never added
+	int32 FindUser(const int32 localUserIndex) const
+	{
+		return m_localUserIndices.Find(localUserIndex);
+	}
+	// adds an empty row for the user, returns the row
+	int32 AddUser(int32 localUserIndex);
+	// the last row moves into the removed one, so the rows stay contiguous
+	bool RemoveUser(int32 localUserIndex);
+	void RemoveRow(int32 row);
+
+	int32 NumUsers() const
+	{
+		return m_localUserIndices.Num();
+	}
+	int32 GetLocalUserIndex(const int32 row) const
+	{
+		return m_localUserIndices[row];
+	}
+
+	// whether the achievement was live at the last Build, the accessors below only take live achievements
+	bool IsLive(const int32 registryIndex) const
+	{
+		return m_columnByIndex[registryIndex] != INDEX_NONE;
+	}
+
+	float GetProgress(const int32 row, const int32 registryIndex) const
+	{
+		return m_progress[GetOffset(row, registryIndex)];
+	}
+	bool IsUnlocked(const int32 row, const int32 registryIndex) const
+	{
+		return m_unlocked[GetOffset(row, registryIndex)];
+	}
+	void SetProgress(const int32 row, const int32 registryIndex, const float progress)
+	{
+		m_progress[GetOffset(row, registryIndex)] = progress;
+	}
+	// unlockedTicks should be UTC (FDateTime::UtcNow().GetTicks())
+	void Unlock(const int32 row, const int32 registryIndex, const int64 unlockedTicks)
+	{
+		const int32 offset = GetOffset(row, registryIndex);
+		m_unlocked[offset] = true;
+		m_unlockedTicks[offset] = unlockedTicks;
+	}
+	// any achievement, the ones of inactive sets come from what the user made on them before
+	FAchievementProgress GetProgressStruct(int32 row, int32 registryIndex) const;
+
+	// adds to an achievement that tracks its own progress, unlocking it (and the composites depending on it) at its goal
+	// the registry index of everything that got unlocked is added to outUnlocked
+	void IncreaseProgress(int32 row, const FAchievementRegistry& registry, int32 registryIndex, float increase, TArray<int32>& outUnlocked);
+	// recounts the unlocked dependencies of every live composite, used after loading or rebuilding
+	void RefreshComposites(int32 row, const FAchievementRegistry& registry, TArray<int32>& outUnlocked);
+
+	// conversions by LinkID, used for the save file and to keep the progress across registry rebuilds
+	// only needs the LinkIDs remembered by Build, so it still works after the registry itself was rebuilt
+	void Export(int32 row, FAchievementProgressStore& outStore) const;
+	// achievements missing from the store start empty, entries for unknown achievements are dropped
+	// and the ones of inactive sets are only kept if there is any progress on them
+	void Import(int32 row, const FAchievementRegistry& registry, const FAchievementProgressStore& store);
+	// keeps the highest progress and every unlock of both, for saves that finish loading after the row is already in use
+	void Merge(int32 row, const FAchievementRegistry& registry, const FAchievementProgressStore& store);
+
+private:
+	int32 GetOffset(const int32 row, const int32 registryIndex) const
+	{
+		return row * m_rowSize + m_columnByIndex[registryIndex];
+	}
+	void ResetRow(int32 row);
+	void UnlockWithDependents(int32 row, const FAchievementRegistry& registry, int32 registryIndex, TArray<int32>& outUnlocked);
+	// live or not, an unlocked dependency of an inactive set still counts towards its composites
+	bool IsDependencyUnlocked(int32 row, int32 registryIndex) const;
+	// keeps the highest progress and the earliest unlock of the store's entry, skipped if there's nothing to keep
+	void MergeInactive(int32 row, const FAchievementProgressStore& store, int32 storeIndex);
+
+	TArray<int32> m_localUserIndices;
+	int32 m_rowSize = 0;
+	// per registry index, taken from the registry in Build (INDEX_NONE for achievements of inactive sets)
+	TArray<int32> m_columnByIndex;
+	TArray<int32> m_linkIDs;
+	// per row, the progress on achievements without a column
+	TArray<FAchievementProgressStore> m_inactiveProgress;
+
+	// row-major, every user's achievements next to each other
+	TArray<float> m_progress;
+	TBitArray<> m_unlocked;
+	TArray<int64> m_unlockedTicks;
+};
@@ -1,7 +1,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/IConsoleManager.h"
 
 // Declare your custom log category
 DECLARE_LOG_CATEGORY_EXTERN(AchievementLog,	 Log, All);
-DECLARE_LOG_CATEGORY_EXTERN(AchievementPlatformLog, Log, All);
\ No newline at end of file
+DECLARE_LOG_CATEGORY_EXTERN(AchievementPlatformLog, Log, All);
+
+// Achievements.VerboseLogging, off by default so the hot paths don't format a string per event
+extern ACHIEVEMENTPLUGIN_API TAutoConsoleVariable<bool> CVarAchievementVerboseLogging;
+
+// per-event logging (every progress update, every platform write), only does anything while Achievements.VerboseLogging is on
+#define ACHIEVEMENT_LOG_VERBOSE(CategoryName, Verbosity, Format, ...) \
+	do \
+	{ \
+		if (CVarAchievementVerboseLogging.GetValueOnAnyThread()) \
+		{ \
+			UE_LOG(CategoryName, Verbosity, Format, ##__VA_ARGS__); \
+		} \
+	} while (0)
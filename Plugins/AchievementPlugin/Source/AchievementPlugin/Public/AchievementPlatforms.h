@@ -25,7 +25,14 @@ public:
 	bool InitializePlatform(const EAchievementPlatforms platform);
 	static void ShutdownPlatform();
 
-	static bool SetPlatformAchievementProgress(const FAchievementPlatformData& platformData, int32 progress, bool unlocked);
+	// when bStoreImmediately is false the change is only queued on the platform, call StorePlatformProgress afterwards
+	static bool SetPlatformAchievementProgress(const FAchievementPlatformData& platformData, int32 progress, bool unlocked, bool bStoreImmediately = true);
+	// stats are written once per change, no matter how many achievements watch them
+	static bool SetPlatformStat(const FAchievementStatPlatformData& platformData, EAchievementStatType type, double value, bool bStoreImmediately = true);
+	// average rate stats only send what happened since the last update
+	static bool UpdatePlatformAverageRateStat(const FAchievementStatPlatformData& platformData, double count, double seconds, bool bStoreImmediately = true);
+	// sends all queued stat and achievement changes to the platform at once
+	static bool StorePlatformProgress();
 	static bool PlatformDeleteAchievementProgress(const FAchievementPlatformData& platformData);
 	static bool PlatformDeleteAllAchievementProgress();
 
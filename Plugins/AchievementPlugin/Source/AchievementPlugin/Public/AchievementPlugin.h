@@ -7,6 +7,23 @@
 #include "AchievementPlatformsEnum.h"
 #include "Engine/DeveloperSettings.h"
 #include "AchievementStructs.h"
+#include "AchievementRegistry.h"
+#include "AchievementProgressStore.h"
+#include "AchievementStatStore.h"
+#include "AchievementProgressQueue.h"
+#include "AchievementCounterShards.h"
+#include "AchievementDiagnostics.h"
+#include "AchievementListenerRegistry.h"
+#include "AchievementWindowedCounters.h"
+#include "AchievementLocalUserProgress.h"
+#include "AchievementServerPlayerStore.h"
+#include "AchievementActiveSet.h"
+#include "AchievementProgressSnapshot.h"
+#include "AchievementTransaction.h"
+#include "AchievementTagBindings.h"
+#include "AchievementConditions.h"
+#include "AchievementSetSchedule.h"
+#include "Tickable.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "Engine/Engine.h"
 #include "Engine/World.h"
@@ -74,10 +91,42 @@ public:
 			  ToolTip = "Key: Name used for modifying achievementsData in Blueprint Nodes, Value: Achievement settings"))
 	TMap<FString, FAchievementData> achievementsData;
 
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Achievements", meta = (DisplayName = "StatsData",
+			  ToolTip = "Key: Name used for updating the stat in Blueprint Nodes and for the achievements' Watched Stat, Value: Stat settings"))
+	TMap<FString, FAchievementStatData> statsData;
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Achievements", meta = (DisplayName = "AchievementSets",
+			  ToolTip = "Key: Name used for the achievements' Achievement Set, Value: when the set's achievements are available"))
+	TMap<FString, FAchievementSetData> achievementSets;
+
 	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Achievement Settings", meta = (DisplayName = "Cleanup Achievements on Load",
 			  ToolTip = "If enabled, will delete any achievement progress for achievements that no longer exist"))
 	bool bCleanupAchievements = true;
 
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Achievement Settings", meta = (DisplayName = "Progress Queue Capacity", ClampMin = "64",
+			  ToolTip = "Amount of progress reports from other threads that can be queued per frame before falling back to a slower (allocating) queue"))
+	int32 progressQueueCapacity = 4096;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Achievement Settings", meta = (DisplayName = "Counter Merge Interval", ClampMin = "0", Units = "Seconds",
+			  ToolTip = "How often counters from IncrementCounter get merged into the achievement progress (unlocks and platform uploads only happen then). 0 merges every frame"))
+	float counterMergeInterval = 0.25f;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Achievement Settings", meta = (DisplayName = "Auto Save Interval", ClampMin = "0", Units = "Seconds",
+			  ToolTip = "How often the progress gets saved (async) if it changed since the last save. 0 only saves when asked to and when the game closes"))
+	float autoSaveInterval = 0.f;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Server Settings", meta = (DisplayName = "Server Player Save Interval", ClampMin = "1", Units = "Seconds",
+			  ToolTip = "Dedicated servers: how often the progress of players that changed gets saved"))
+	float serverPlayerSaveInterval = 60.f;
+
+	UPROPERTY(config, EditAnywhere, BlueprintReadOnly, Category = "Server Settings", meta = (DisplayName = "Server Player Saves Per Frame", ClampMin = "1",
+			  ToolTip = "Dedicated servers: at most this many player saves get started per frame, the rest waits for the next frames"))
+	int32 serverPlayerSavesPerFrame = 8;
+
+	UPROPERTY(config, EditAnywhere, Category = "Achievement Settings", meta = (DisplayName = "Achievement ID Header Path",
+			  ToolTip = "Where the generated AchievementIds.h gets written, relative to the project folder. Leave empty to write it into the plugin's Public folder"))
+	FString achievementIdHeaderPath = "";
+
 #if WITH_EDITORONLY_DATA
 	UPROPERTY(EditAnywhere, Category = "Achievements Settings Buttons", Transient, meta = (DisplayName = "Load/Update Runtime Stats",
 			  Tooltip = "Enable this to update the runtime stats (progress) of the achievementsData"))
@@ -88,6 +137,9 @@ public:
 	// TEMP DELETE
 	UPROPERTY(EditAnywhere, Category = "Achievements Settings Buttons", Transient, meta = (DisplayName = "Force Load Achievement Progress"))
 	bool bForceLoadAchievementProgress = false;
+	UPROPERTY(EditAnywhere, Category = "Achievements Settings Buttons", Transient, meta = (DisplayName = "Generate Achievement ID Header",
+			  Tooltip = "Writes AchievementIds.h with a compile-time EAchievementId for every achievement, regenerate it whenever achievements are added or removed"))
+	bool bGenerateAchievementIdHeader = false;
 
 
 	// Platform-dependant buttons
@@ -133,10 +185,17 @@ private:
 	int32 m_steamAppID;
 };
 
+// every achievement that changed this frame, broadcast once at the end of the frame instead of once per change
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnAchievementsChanged, const TArray<FAchievementHandle>&, handles);
+// an achievement a split-screen user unlocked, broadcast at the end of the frame as well
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnLocalUserAchievementUnlocked, int32, localUserIndex, FAchievementHandle, handle);
+// an achievement a player on the dedicated server unlocked, for example to tell the owning client
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnServerPlayerAchievementUnlocked, const FUniqueNetIdRepl&, playerId, FAchievementHandle, handle);
+
 class UAchievementSaveManager;
 UCLASS()
 // Note: If a default UI ever gets added, change this into a UGameEngineSubsystem and remove the buttons from the class above
-class ACHIEVEMENTPLUGIN_API UAchievementManagerSubSystem : public UEngineSubsystem
+class ACHIEVEMENTPLUGIN_API UAchievementManagerSubSystem : public UEngineSubsystem, public FTickableGameObject
 {
 	GENERATED_BODY()
 
@@ -151,26 +210,344 @@ public:
 	virtual void Deinitialize() override;
 
 	// creates Progress for any achievements without them
+	// call this after changing the progress store directly (loading, resetting), it also rebuilds the set of locked achievements
 	void InitializeAchievements();
 
 	// this will remove any achievements progress towards achievements that no longer exist
 	void CleanupAchievements();
 
+	// (re)builds the runtime registry from the settings, call this whenever achievementsData changes
+	// every handle changes, so this is for loading and editing only, sets starting or ending never rebuild it
+	void RebuildRegistry();
+	bool IsAchievementSetActive(const FName setId) const
+	{
+		return m_setSchedule.IsSetActive(setId);
+	}
+	const FAchievementRegistry& GetRegistry() const
+	{
+		return m_registry;
+	}
+
+	// resolves the achievement once, the handle can then be used for any following progress updates
+	FAchievementHandle GetAchievementHandle(FName achievementId) const;
+	// NAME_None for invalid handles
+	FName GetAchievementId(FAchievementHandle handle) const;
+	// empty progress for invalid handles
+	FAchievementProgress GetAchievementProgress(FAchievementHandle handle) const;
+
 	// Sets the progress for the achievement, including updating platforms
-	bool IncreaseAchievementProgress(const FString& achievementId, float increase);
+	bool IncreaseAchievementProgress(FName achievementId, float increase, EAchievementUpdateMode mode = EAchievementUpdateMode::Immediate);
+	// same as above but without any string lookups, use this for frequent updates
+	bool IncreaseAchievementProgress(FAchievementHandle handle, float increase, EAchievementUpdateMode mode = EAchievementUpdateMode::Immediate);
+	// applies all changes locally first and then sends them to the platform with a single store
+	// returns how many of the changes could be applied
+	int32 IncreaseAchievementProgressBatch(TArrayView<const FAchievementProgressChange> changes);
+
+	// sends every locally changed achievement to the platform, followed by one store
+	// also marks the progress dirty for the auto save
+	void FlushPlatformProgress();
+	// the next auto save writes the progress, see autoSaveInterval
+	void MarkSaveDirty()
+	{
+		m_bSaveDirty = true;
+	}
 
-	UPROPERTY(BlueprintReadOnly, SaveGame, Category = "Achievements")
-	// the 'Key' is the LinkID that the achievementData has
-	TMap<int32, FAchievementProgress> achievementsProgress;
+	// thread-safe, queues the change and applies it on the game thread during the next tick
+	// Note: resolve the handle on the game thread once, handles stay valid until the registry gets rebuilt
+	void ReportProgress(FAchievementHandle handle, float increase);
+	// applies everything ReportProgress queued so far, game thread only
+	void DrainProgressQueue();
+
+	// thread-safe and contention free, meant for events that fire thousands of times per second
+	// the counted amount only gets applied (including unlock checks and platform uploads) when the counters are merged
+	void IncrementCounter(FAchievementHandle handle, int32 amount = 1);
+	// merges all counters into the progress right away instead of waiting for the next merge interval, game thread only
+	void MergeCounters();
+
+	// applies everything added with EAchievementUpdateMode::Accumulate, this already happens at the end of every frame
+	void ApplyAccumulatedProgress();
+
+	// adds magnitude to every achievement whose gameplay event query matches the tag, uploaded with a single flush
+	// returns how many achievements the event counted towards
+	int32 ReportGameplayEvent(FGameplayTag eventTag, float magnitude = 1.f);
+
+	// clears the progress of every windowed achievement that resets with the scope (call it when the player dies, a match ends, ...)
+	// O(1) no matter how many achievements use the scope, their visible progress is updated at the end of the frame
+	void ResetAchievementScope(EAchievementScope scope);
+
+	// whether the achievement is live and tracks its own progress (no watched stat, dependencies or unlock condition), logs why not
+	// the same check IncreaseAchievementProgress, transactions and the other users' progress go through
+	bool CanChangeProgress(FAchievementHandle handle) const;
+	// whether SetStat/IncreaseStat can change the stat (valid and not an average rate), logs why not
+	bool CanChangeStat(FAchievementStatHandle handle) const;
+
+	// resolves the stat once, the handle can then be used for any following stat updates
+	FAchievementStatHandle GetStatHandle(FName statId) const;
+	// updates the stat and every achievement watching it right away, the stat is sent to the platform once at the end of the frame
+	// doubles like the stat store, so large int stats (footsteps, bullets fired) keep counting past 2^24
+	bool IncreaseStat(FName statId, double increase);
+	bool IncreaseStat(FAchievementStatHandle handle, double increase);
+	bool SetStat(FAchievementStatHandle handle, double value);
+	// only for AverageRate stats, adds count events that happened over the given seconds
+	bool AddAverageRateSample(FAchievementStatHandle handle, double count, double seconds);
+	// the value watching achievements compare against, count per second for AverageRate stats
+	double GetStatValue(FAchievementStatHandle handle) const;
+
+	// split-screen: every other local user (platform user or controller ID) gets its own row next to the others
+	// the primary user (PrimaryLocalUser) keeps the full progress pipeline, it is the only one driving stats, windows and the platform
+	static constexpr int32 PrimaryLocalUser = 0;
+	// loads the user's own save once, afterwards updates never save or load until the user gets removed again
+	bool AddLocalUser(int32 localUserIndex);
+	// frees the user's row, saving its progress first if bSave
+	bool RemoveLocalUser(int32 localUserIndex, bool bSave = true);
+	bool IsLocalUserAdded(int32 localUserIndex) const;
+	// sync, meant for when a user leaves or the game closes
+	bool SaveLocalUserProgress(int32 localUserIndex) const;
+	// the PrimaryLocalUser goes through IncreaseAchievementProgress, other users only support achievements tracking their own progress
+	bool IncreaseAchievementProgressForUser(int32 localUserIndex, FAchievementHandle handle, float increase);
+	FAchievementProgress GetAchievementProgressForUser(int32 localUserIndex, FAchievementHandle handle) const;
+
+	// dedicated servers: authoritative progress for every connected player, keyed by unique net ID
+	// only local progress, the platform is never involved (tell the clients through OnServerPlayerAchievementUnlocked)
+	// starts loading the player's save, progress made before it finished loading is kept
+	bool AddServerPlayer(const FUniqueNetIdRepl& playerId);
+	bool RemoveServerPlayer(const FUniqueNetIdRepl& playerId, bool bSave = true);
+	// thread-safe (sets starting or ending included, not registry rebuilds), only for achievements tracking their own progress
+	// achievements of inactive sets are rejected by the player's shard, against the live achievements its rows were laid out for
+	bool IncreaseServerPlayerProgress(const FUniqueNetIdRepl& playerId, FAchievementHandle handle, float increase);
+	// thread-safe, the same change for every player (everyone in this match gets +1 games played), returns how many players got it
+	int32 IncreaseServerPlayersProgress(TConstArrayView<FUniqueNetIdRepl> playerIds, FAchievementHandle handle, float increase);
+	FAchievementProgress GetServerPlayerProgress(const FUniqueNetIdRepl& playerId, FAchievementHandle handle) const;
+	// queues a save for every player that changed, they are spread over the next frames (this happens every serverPlayerSaveInterval already)
+	void QueueServerPlayerSaves();
+	FAchievementServerPlayerStore& GetServerPlayerStore()
+	{
+		return m_serverPlayers;
+	}
+
+	// logs the aggregated progress/platform counters, also available as the Achievements.DumpDiagnostics console command
+	void LogDiagnosticsSummary(bool bResetCounters = false);
+	// evaluates every unlock condition the given number of times and logs how long it took, nothing gets unlocked
+	void BenchmarkConditions(int32 iterations) const;
+
+	// overrides for the Tickable
+	virtual void Tick(float deltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override
+	{
+		return ETickableTickType::Conditional;
+	}
+	virtual bool IsTickable() const override
+	{
+		return m_bInitialized;
+	}
+	virtual bool IsTickableWhenPaused() const override
+	{
+		return true;
+	}
+	virtual bool IsTickableInEditor() const override
+	{
+		return true;
+	}
+	virtual TStatId GetStatId() const override
+	{
+		RETURN_QUICK_DECLARE_CYCLE_STAT(UAchievementManagerSubSystem, STATGROUP_Tickables);
+	}
+
+	FAchievementProgressStore& GetProgressStore()
+	{
+		return m_progressStore;
+	}
+	const FAchievementProgressStore& GetProgressStore() const
+	{
+		return m_progressStore;
+	}
+	FAchievementStatStore& GetStatStore()
+	{
+		return m_statStore;
+	}
+	const FAchievementStatStore& GetStatStore() const
+	{
+		return m_statStore;
+	}
+	// thread-safe and lock-free, the progress as of the end of the last frame in which it changed
+	// Note: the pin has to be released before the subsystem gets deinitialized
+	FAchievementSnapshotBuffer::FPin PinProgressSnapshot() const
+	{
+		return m_snapshots.Pin();
+	}
+
+	// registry indices of every achievement that is still locked, for UI and other passes over the whole catalog
+	TConstArrayView<int32> GetLockedAchievements() const
+	{
+		return m_activeSet.GetActive();
+	}
+
+	// builds the Blueprint view of the progress store, the 'Key' is the LinkID that the achievementData has
+	UFUNCTION(BlueprintGetter)
+	TMap<int32, FAchievementProgress> GetAchievementsProgress() const;
+
+	// listener is called at the end of every frame in which the achievement's progress changed
+	// returns the id for UnsubscribeFromAchievement, INDEX_NONE if the achievement does not exist
+	int32 SubscribeToAchievement(FAchievementHandle handle, const FOnAchievementProgressUpdated& listener);
+	int32 SubscribeToAchievement(FName achievementId, const FOnAchievementProgressUpdated& listener);
+	bool UnsubscribeFromAchievement(int32 subscriptionId);
+	// removes every achievement subscription of the object (destroyed objects are cleaned up automatically as well)
+	int32 UnsubscribeAllFromAchievements(const UObject* listenerObject);
+
+	// achievements that got unlocked this frame
+	UPROPERTY(BlueprintAssignable, Category = "Achievements")
+	FOnAchievementsChanged OnAchievementsUnlocked;
+	// achievements whose progress changed this frame (unlocked ones included)
+	UPROPERTY(BlueprintAssignable, Category = "Achievements")
+	FOnAchievementsChanged OnProgressChanged;
+	// achievements additional local users unlocked this frame, the primary user's unlocks go through OnAchievementsUnlocked
+	UPROPERTY(BlueprintAssignable, Category = "Achievements")
+	FOnLocalUserAchievementUnlocked OnLocalUserAchievementUnlocked;
+	// achievements players on the dedicated server unlocked since the last frame
+	UPROPERTY(BlueprintAssignable, Category = "Achievements")
+	FOnServerPlayerAchievementUnlocked OnServerPlayerAchievementUnlocked;
 
 	UFUNCTION()
 	static void OnWorldInitialized(const UWorld* world);
 	UFUNCTION()
 	static void OnWorldCleanup(const UWorld* world, bool bSessionEnded, bool bCleanupResources);
 private:
+	friend class FAchievementTransaction;
+
 	UPROPERTY()
 	UAchievementSaveManager* m_saveManager;
 
+	FAchievementRegistry m_registry;
+	FAchievementProgressStore m_progressStore;
+	FAchievementStatStore m_statStore;
+	// which sets are active, the registry holds every achievement but only the live ones get evaluated
+	FAchievementSetSchedule m_setSchedule;
+	// tag -> achievements lookup for ReportGameplayEvent, built together with the registry
+	FAchievementTagBindings m_tagBindings;
+	// compiled unlockCondition expressions, built together with the registry
+	FAchievementConditions m_conditions;
+	// the still locked achievements, rebuilt by InitializeAchievements and shrunk by UnlockAchievement
+	FAchievementActiveSet m_activeSet;
+
+	// updates the local progress only and queues the platform write
+	// returns false if the handle is invalid or the achievement can't change (inactive set included), true for unlocked ones
+	bool ApplyProgressIncrease(FAchievementHandle handle, float increase);
+	FAchievementHandle ResolveProgressChange(const FAchievementProgressChange& change) const;
+	// applies a transaction's folded changes, stats first so their watchers unlock through the threshold cursors
+	// validates every change first and applies nothing if one fails, evaluates the unlock conditions of the changed stats
+	// and ends with a single platform flush
+	// returns how many achievements and stats were changed
+	int32 CommitTransaction(TConstArrayView<FAchievementProgressChange> progressChanges, TConstArrayView<FAchievementTransactionStatChange> statChanges);
+	void QueuePlatformWrite(int32 registryIndex);
+	// unlocks the achievement (which has to be locked) and re-evaluates only the composites depending on it
+	void UnlockAchievement(int32 registryIndex);
+	// recounts the unlocked dependencies of every composite, used after loading or rebuilding
+	void RefreshCompositeAchievements();
+	// expires old progress of every window and updates the progress of the windowed achievements that changed
+	void AdvanceWindows();
+	// logs and queues the events for what an additional local user unlocked (no platform, no stats)
+	void QueueLocalUserUnlocks(int32 row, TArrayView<const int32> unlockedIndices);
+	void RefreshLocalUserComposites(int32 row);
+	// CanChangeProgress without the live check, only reads what the registry was built with (safe from any thread until it's rebuilt)
+	bool CanChangeOwnProgress(FAchievementHandle handle) const;
+	// CanChangeProgress, and windowed achievements only exist for the primary user
+	// bCheckLive false leaves the live check to the caller, the server shards do it under their lock
+	bool CanChangeSecondaryUserProgress(FAchievementHandle handle, bool bCheckLive = true) const;
+	// starts the queued server player saves, at most serverPlayerSavesPerFrame of them
+	void SaveQueuedServerPlayers();
+
+	// collected during the frame, DispatchAchievementEvents broadcasts them once
+	void MarkProgressChanged(int32 registryIndex);
+	void MarkUnlocked(int32 registryIndex);
+	void DispatchAchievementEvents();
+
+	// stores the new value, queues the stat's platform write and fans it out to the watching achievements
+	void ApplyStatValue(FAchievementStatHandle handle, double value);
+	// unlocks every threshold the stat crossed, the progress of the others gets synced at the end of the frame
+	void ApplyStatToWatchers(FAchievementStatHandle handle);
+	// brings every stat-driven achievement up to date with its stat, used after loading or rebuilding
+	void RefreshStatAchievements();
+	// writes the stat value into the progress of the locked watchers of every stat that changed
+	void SyncStatProgress();
+	// updates the schedule, the live bits and the tag bindings for the sets that are active now
+	// and lays the other users' rows out again, they only hold the live achievements
+	void BuildLiveAchievements();
+	// evaluates the conditions whose stats changed since the last call and unlocks the ones that hold
+	void EvaluateDirtyConditions();
+	void MarkConditionsDirty(int32 statIndex);
+
+	// registry indices that still have to be sent to the platform, the bits make sure every index is only queued once
+	TArray<int32> m_pendingPlatformWrites;
+	TBitArray<> m_hasPendingPlatformWrite;
+
+	// same for stats, average rate stats also keep what was added since their last platform write
+	TArray<int32> m_pendingStatWrites;
+	TBitArray<> m_hasPendingStatWrite;
+	TArray<double> m_pendingRateCounts;
+	TArray<double> m_pendingRateSeconds;
+
+	// conditions that read a stat which changed, each one is evaluated once per frame however often its stats change
+	TArray<int32> m_dirtyConditions;
+	TBitArray<> m_hasDirtyCondition;
+
+	// changes since the last dispatch, the bits make sure every handle is only in there once
+	TArray<FAchievementHandle> m_changedHandles;
+	TBitArray<> m_hasChanged;
+	TArray<FAchievementHandle> m_unlockedHandles;
+	// targeted listeners, only notified for the achievements in m_changedHandles
+	FAchievementListenerRegistry m_listeners;
+
+	// the additional local users' progress, all loaded at once so switching between them is free
+	FAchievementLocalUserProgress m_localUsers;
+	TArray<TPair<int32, FAchievementHandle>> m_localUserUnlocks;
+
+	// dedicated servers only, filled through AddServerPlayer
+	FAchievementServerPlayerStore m_serverPlayers;
+	TArray<FUniqueNetIdRepl> m_serverSaveQueue;
+	// players that left before their save finished loading, saved once it's there and merged with what they did meanwhile
+	TMap<FUniqueNetIdRepl, FAchievementProgressStore> m_pendingServerPlayerSaves;
+	float m_timeSinceServerPlayerSave = 0.f;
+
+	// ring buffers for the windowed achievements, their counted progress is never saved
+	FAchievementWindowedCounters m_windowedCounters;
+
+	// per stat, offset of the lowest locked goal inside the sorted watchers, so an update is one comparison until it gets crossed
+	TArray<int32> m_statThresholdCursors;
+	// stats whose watchers' progress still has to be synced
+	TArray<int32> m_staleStatProgress;
+	TBitArray<> m_hasStaleStatProgress;
+
+	// progress reported from other threads, drained once per tick
+	TUniquePtr<FAchievementProgressQueue> m_progressQueue;
+
+	// per-thread counters from IncrementCounter, merged every counterMergeInterval seconds
+	FAchievementCounterShards m_counterShards;
+	float m_timeSinceCounterMerge = 0.f;
+
+	// summed deltas per registry index for EAchievementUpdateMode::Accumulate
+	TArray<float> m_accumulatedDeltas;
+	TArray<int32> m_accumulatedIndices;
+	TBitArray<> m_hasAccumulatedDelta;
+
+	// read-only copies for other threads, republished at the end of every frame in which progress or stats changed
+	FAchievementSnapshotBuffer m_snapshots;
+	bool m_bSnapshotDirty = true;
+
+	// progress changed since the last save, written every autoSaveInterval seconds
+	bool m_bSaveDirty = false;
+	float m_timeSinceAutoSave = 0.f;
+
+	// counters instead of per-event logging, summarized every Achievements.DiagnosticsInterval seconds
+	FAchievementDiagnostics m_diagnostics;
+	float m_timeSinceDiagnosticsSummary = 0.f;
+
+	// only tick between Initialize and Deinitialize (and never for the CDO)
+	bool m_bInitialized = false;
+
+	// kept for Blueprints only, reads go through GetAchievementsProgress so this is never filled
+	UPROPERTY(BlueprintReadOnly, Transient, BlueprintGetter = GetAchievementsProgress, Category = "Achievements", meta = (AllowPrivateAccess = "true"))
+	TMap<int32, FAchievementProgress> achievementsProgress;
+
 	FDelegateHandle m_worldInitializedHandle;
 	FDelegateHandle m_worldCleanupHandle;
 };
@@ -4,6 +4,8 @@
 
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "AchievementPlatformsEnum.h"
+#include "AchievementStructs.h"
+#include "AchievementListenerRegistry.h"
 #include "AchievementPluginBPLibrary.generated.h"
 
 
@@ -24,8 +26,100 @@ public:
 
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Change Achievement Progress", Keywords = "Change Achievement Progress"), Category = "AchievementPlugin")
 	static bool IncreaseAchievementProgress(
-		const FString& localAchievementId,
-		float change);
+		FName localAchievementId,
+		float change,
+		EAchievementUpdateMode mode = EAchievementUpdateMode::Immediate);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Achievement Handle", Keywords = "Get Achievement Handle",
+			  Tooltip = "Resolves the achievement once, store the handle and use it for frequent progress changes"), Category = "AchievementPlugin")
+	static FAchievementHandle GetAchievementHandle(FName localAchievementId);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Is Valid Achievement Handle", Keywords = "Is Valid Achievement Handle"), Category = "AchievementPlugin")
+	static bool IsValidAchievementHandle(const FAchievementHandle& handle);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Achievement ID", Keywords = "Get Achievement ID Name Handle",
+			  Tooltip = "The achievement's name, for example to look up its settings for handles from the OnAchievementsUnlocked/OnProgressChanged events"), Category = "AchievementPlugin")
+	static FName GetAchievementIdFromHandle(const FAchievementHandle& handle);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Achievement Progress By Handle", Keywords = "Get Achievement Progress Handle"), Category = "AchievementPlugin")
+	static FAchievementProgress GetAchievementProgressByHandle(const FAchievementHandle& handle);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Subscribe To Achievement", Keywords = "Subscribe Listen Bind Achievement",
+			  Tooltip = "Calls the event at the end of every frame in which this achievement's progress changed. Returns the id to unsubscribe with"), Category = "AchievementPlugin")
+	static int32 SubscribeToAchievement(const FAchievementHandle& handle, const FOnAchievementProgressUpdated& listener);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Unsubscribe From Achievement", Keywords = "Unsubscribe Unbind Achievement"), Category = "AchievementPlugin")
+	static bool UnsubscribeFromAchievement(int32 subscriptionId);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Change Achievement Progress By Handle", Keywords = "Change Achievement Progress Handle"), Category = "AchievementPlugin")
+	static bool IncreaseAchievementProgressByHandle(
+		const FAchievementHandle& handle,
+		float change,
+		EAchievementUpdateMode mode = EAchievementUpdateMode::Immediate);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Increment Achievement Counter", Keywords = "Increment Achievement Counter",
+			  Tooltip = "Cheap increment for very frequent events, the progress gets applied the next time counters are merged"), Category = "AchievementPlugin")
+	static void IncrementAchievementCounter(const FAchievementHandle& handle, int32 amount = 1);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Change Achievement Progress Batch", Keywords = "Change Achievement Progress Batch",
+			  Tooltip = "Applies all changes at once and sends them to the platform in a single upload. Returns how many changes were applied"), Category = "AchievementPlugin")
+	static int32 IncreaseAchievementProgressBatch(const TArray<FAchievementProgressChange>& changes);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Report Gameplay Event", Keywords = "Report Gameplay Event Tag Achievement",
+			  Tooltip = "Adds the magnitude to every achievement whose Gameplay Event Query matches the tag. Returns how many achievements it counted towards"), Category = "AchievementPlugin")
+	static int32 ReportGameplayEvent(FGameplayTag eventTag, float magnitude = 1.f);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Reset Achievement Scope", Keywords = "Reset Achievement Scope Life Match Session Window",
+			  Tooltip = "Clears the progress of every windowed achievement that resets with this scope, for example when the player dies"), Category = "AchievementPlugin")
+	static void ResetAchievementScope(EAchievementScope scope);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Local User", Keywords = "Add Local User Split Screen Player",
+			  Tooltip = "Loads the progress of an additional split-screen user (platform user or controller ID), local user 0 is the primary user and always exists"), Category = "AchievementPlugin|Local Users")
+	static bool AddLocalUser(int32 localUserIndex);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Remove Local User", Keywords = "Remove Local User Split Screen Player",
+			  Tooltip = "Saves (if enabled) and unloads the progress of a split-screen user"), Category = "AchievementPlugin|Local Users")
+	static bool RemoveLocalUser(int32 localUserIndex, bool bSave = true);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Change Achievement Progress For User", Keywords = "Change Achievement Progress Local User Split Screen"), Category = "AchievementPlugin|Local Users")
+	static bool IncreaseAchievementProgressForUser(int32 localUserIndex, const FAchievementHandle& handle, float change);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Achievement Progress For User", Keywords = "Get Achievement Progress Local User Split Screen"), Category = "AchievementPlugin|Local Users")
+	static FAchievementProgress GetAchievementProgressForUser(int32 localUserIndex, const FAchievementHandle& handle);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Change Server Player Achievement Progress", Keywords = "Change Achievement Progress Server Player Net ID",
+			  Tooltip = "Dedicated servers: changes the progress of a player added with AddServerPlayer"), Category = "AchievementPlugin|Server")
+	static bool IncreaseServerPlayerProgress(const FUniqueNetIdRepl& playerId, const FAchievementHandle& handle, float change);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Change Server Players Achievement Progress", Keywords = "Change Achievement Progress Server Players Bulk Match",
+			  Tooltip = "Dedicated servers: the same change for every given player, returns how many players got it"), Category = "AchievementPlugin|Server")
+	static int32 IncreaseServerPlayersProgress(const TArray<FUniqueNetIdRepl>& playerIds, const FAchievementHandle& handle, float change);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Stat Handle", Keywords = "Get Stat Handle",
+			  Tooltip = "Resolves the stat once, store the handle and use it for frequent stat changes"), Category = "AchievementPlugin|Stats")
+	static FAchievementStatHandle GetStatHandle(FName statId);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Increase Stat", Keywords = "Increase Change Stat",
+			  Tooltip = "Changes the stat and every achievement watching it"), Category = "AchievementPlugin|Stats")
+	static bool IncreaseStat(FName statId, float increase);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Increase Stat By Handle", Keywords = "Increase Change Stat Handle"), Category = "AchievementPlugin|Stats")
+	static bool IncreaseStatByHandle(const FAchievementStatHandle& handle, float increase);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Set Stat", Keywords = "Set Stat"), Category = "AchievementPlugin|Stats")
+	static bool SetStat(const FAchievementStatHandle& handle, float value);
+
+	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Add Average Rate Sample", Keywords = "Average Rate Stat",
+			  Tooltip = "For Average Rate stats, adds 'count' events that happened over 'seconds'"), Category = "AchievementPlugin|Stats")
+	static bool AddAverageRateSample(const FAchievementStatHandle& handle, float count, float seconds);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Get Stat Value", Keywords = "Get Stat Value",
+			  Tooltip = "The stat's value, count per second for Average Rate stats"), Category = "AchievementPlugin|Stats")
+	static float GetStatValue(const FAchievementStatHandle& handle);
+
+	UFUNCTION(BlueprintPure, meta = (DisplayName = "Format Achievement Unlock Time", Keywords = "Format Achievement Unlock Time Date",
+			  Tooltip = "Formats the unlock time in the player's local time zone, or 'Never' if it was never unlocked"), Category = "AchievementPlugin")
+	static FText FormatAchievementUnlockTime(const FAchievementProgress& progress);
 
 	UFUNCTION(BlueprintCallable, meta = (DisplayName = "Save Achievement Progress Async", Keywords = "Save Achievement Progress Async"), Category = "AchievementPlugin")
 	static bool SaveAchievementProgressAsync();
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/MpscQueue.h"
+#include <atomic>
+
+// a single progress change reported from any thread
+struct FAchievementQueuedProgress
+{
+	int32 registryIndex = INDEX_NONE;
+	float delta = 0.f;
+};
+
+// lock-free multi-producer, single-consumer queue for progress reported outside the game thread
+// producers claim a slot in a bounded ring buffer with one CAS, the game thread is the only consumer
+// Note: if the ring is full the entry goes into an unbounded overflow queue instead, so nothing gets dropped
+class ACHIEVEMENTPLUGIN_API FAchievementProgressQueue
+{
+public:
+	// capacity gets rounded up to a power of two
+	explicit FAchievementProgressQueue(uint32 capacity = 4096);
+	~FAchievementProgressQueue();
+
+	FAchievementProgressQueue(const FAchievementProgressQueue&) = delete;
+	FAchievementProgressQueue& operator=(const FAchievementProgressQueue&) = delete;
+
+	// safe to call from any thread
+	void Enqueue(const FAchievementQueuedProgress& item);
+
+	// only call this from the consuming thread, returns false once the queue is empty
+	bool Dequeue(FAchievementQueuedProgress& outItem);
+
+	uint32 GetCapacity() const
+	{
+		return m_mask + 1;
+	}
+
+private:
+	struct FCell
+	{
+		std::atomic<uint32> sequence;
+		FAchievementQueuedProgress item;
+	};
+
+	bool TryEnqueueRing(const FAchievementQueuedProgress& item);
+	bool TryDequeueRing(FAchievementQueuedProgress& outItem);
+
+	FCell* m_cells = nullptr;
+	uint32 m_mask = 0;
+
+	// kept on separate cache lines so producers and the consumer don't fight over them
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint32> m_enqueuePosition{0};
+	alignas(PLATFORM_CACHE_LINE_SIZE) uint32 m_dequeuePosition = 0;
+
+	TMpscQueue<FAchievementQueuedProgress> m_overflow;
+};
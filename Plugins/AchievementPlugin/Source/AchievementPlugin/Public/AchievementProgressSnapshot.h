@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementProgressStore.h"
+#include "AchievementStatStore.h"
+#include <atomic>
+
+// read-only copy of the primary user's progress and stats, published by the game thread
+struct ACHIEVEMENTPLUGIN_API FAchievementProgressSnapshot
+{
+	// increases with every publish, readers can skip their work if it didn't change since they last looked
+	uint64 version = 0;
+	FAchievementProgressStore progress;
+	FAchievementStatStore stats;
+};
+
+// lock-free progress snapshots for other threads (analytics, UI workers, background saves)
+// the game thread fills a slot nobody has pinned and then swaps it in, readers pin the current slot with one atomic increment
+// the game thread never waits on readers, if every spare slot is still pinned publishing is skipped until one gets released
+class ACHIEVEMENTPLUGIN_API FAchievementSnapshotBuffer
+{
+	struct FSlot
+	{
+		FAchievementProgressSnapshot snapshot;
+		mutable std::atomic<int32> pins{0};
+	};
+
+public:
+	static constexpr int32 NumSlots = 4;
+
+	// keeps the snapshot alive (and unchanged) until it goes out of scope, hold it as briefly as possible
+	class FPin
+	{
+	public:
+		FPin() = default;
+		explicit FPin(const FSlot* slot)
+			: m_slot(slot)
+		{
+		}
+		~FPin()
+		{
+			Release();
+		}
+		FPin(FPin&& other)
+			: m_slot(other.m_slot)
+		{
+			other.m_slot = nullptr;
+		}
+		FPin& operator=(FPin&& other)
+		{
+			if (this != &other)
+			{
+				Release();
+				m_slot = other.m_slot;
+				other.m_slot = nullptr;
+			}
+			return *this;
+		}
+		FPin(const FPin&) = delete;
+		FPin& operator=(const FPin&) = delete;
+
+		// false until the game thread published the first snapshot
+		bool IsValid() const
+		{
+			return m_slot != nullptr;
+		}
+		const FAchievementProgressSnapshot* operator->() const
+		{
+			return &m_slot->snapshot;
+		}
+		const FAchievementProgressSnapshot& operator*() const
+		{
+			return m_slot->snapshot;
+		}
+
+	private:
+		void Release()
+		{
+			if (m_slot)
+			{
+				m_slot->pins.fetch_sub(1, std::memory_order_release);
+				m_slot = nullptr;
+			}
+		}
+
+		const FSlot* m_slot = nullptr;
+	};
+
+	// game thread only, returns false if every slot but the current one is still pinned
+	bool Publish(const FAchievementProgressStore& progress, const FAchievementStatStore& stats);
+	// any thread, wait-free unless a publish happens in between (then it simply tries again)
+	FPin Pin() const;
+
+private:
+	FSlot m_slots[NumSlots];
+	std::atomic<int32> m_currentSlot{INDEX_NONE};
+	uint64 m_nextVersion = 1;
+};
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementStructs.h"
+
+// structure-of-arrays storage for all achievement progress, every LinkID gets a stable index into the columns below
+// Note: indices only change when entries get removed (RemoveAll/Empty), anything caching them has to rebind afterwards
+class ACHIEVEMENTPLUGIN_API FAchievementProgressStore
+{
+public:
+	static constexpr int64 NeverUnlockedTicks = FAchievementProgress::NeverUnlockedTicks;
+
+	int32 Num() const
+	{
+		return m_linkIDs.Num();
+	}
+	bool IsValidIndex(const int32 index) const
+	{
+		return m_linkIDs.IsValidIndex(index);
+	}
+
+	// returns INDEX_NONE if there is no progress for the LinkID
+	int32 FindIndex(const int32 linkID) const
+	{
+		const int32* index = m_indexByLinkID.Find(linkID);
+		return index ? *index : INDEX_NONE;
+	}
+	// returns the index for the LinkID, adding empty progress if it did not exist yet
+	int32 FindOrAdd(int32 linkID, bool* bOutWasAdded = nullptr);
+
+	int32 GetLinkID(const int32 index) const
+	{
+		return m_linkIDs[index];
+	}
+	float GetProgress(const int32 index) const
+	{
+		return m_progress[index];
+	}
+	bool IsUnlocked(const int32 index) const
+	{
+		return m_unlocked[index];
+	}
+	int64 GetUnlockedTicks(const int32 index) const
+	{
+		return m_unlockedTicks[index];
+	}
+
+	// whole columns, for snapshotting without going through every entry
+	TConstArrayView<int32> GetLinkIDs() const
+	{
+		return m_linkIDs;
+	}
+	TConstArrayView<float> GetProgressValues() const
+	{
+		return m_progress;
+	}
+	TConstArrayView<int64> GetUnlockedTicksValues() const
+	{
+		return m_unlockedTicks;
+	}
+
+	void SetProgress(const int32 index, const float progress)
+	{
+		m_progress[index] = progress;
+	}
+	// unlockedTicks should be UTC (FDateTime::UtcNow().GetTicks())
+	void Unlock(const int32 index, const int64 unlockedTicks)
+	{
+		m_unlocked[index] = true;
+		m_unlockedTicks[index] = unlockedTicks;
+	}
+	// transient progress (windowed/scoped totals) only lives in memory, the save file gets 0 for it while it's locked
+	void SetTransient(const int32 index, const bool bIsTransient)
+	{
+		m_transient[index] = bIsTransient;
+	}
+	bool IsTransient(const int32 index) const
+	{
+		return m_transient[index];
+	}
+	// the progress as it should be saved
+	float GetSavedProgress(const int32 index) const
+	{
+		return m_transient[index] && !m_unlocked[index] ? 0.f : m_progress[index];
+	}
+
+	// keeps the highest progress and the earliest unlock of both, entries only in other get added
+	void Merge(const FAchievementProgressStore& other);
+
+	// sets the progress back to its defaults but keeps the entry (and its index)
+	void Reset(int32 index);
+	void Empty();
+
+	// removes every entry the predicate returns true for and compacts the columns, returns the amount removed
+	int32 RemoveAll(TFunctionRef<bool(int32 linkID)> predicate);
+
+	// conversions for Blueprints and the save file
+	FAchievementProgress GetProgressStruct(int32 index) const;
+	void SetProgressStruct(int32 index, const FAchievementProgress& progress);
+	TMap<int32, FAchievementProgress> ToMap() const;
+	void FromMap(const TMap<int32, FAchievementProgress>& progressMap);
+
+private:
+	TArray<int32> m_linkIDs;
+	TArray<float> m_progress;
+	TBitArray<> m_unlocked;
+	TArray<int64> m_unlockedTicks;
+	// set by FAchievementRegistry::BindProgress, not part of the save itself
+	TBitArray<> m_transient;
+
+	TMap<int32, int32> m_indexByLinkID;
+};
@@ -0,0 +1,190 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementStructs.h"
+
+class FAchievementProgressStore;
+class FAchievementStatStore;
+
+// runtime copy of everything the progress hot path needs from an achievement's settings
+struct ACHIEVEMENTPLUGIN_API FAchievementRegistryEntry
+{
+	FName achievementId;
+	int32 linkID = 0;
+	int32 progressGoal = 1;
+	FAchievementPlatformData platformData;
+
+	// index of this achievement's progress inside the FAchievementProgressStore
+	int32 progressIndex = INDEX_NONE;
+	// stat index of the watched stat, INDEX_NONE if the achievement tracks its own progress
+	int32 statIndex = INDEX_NONE;
+
+	// composites only: how many dependencies have to be unlocked (also used as progressGoal), 0 for regular achievements
+	int32 requiredDependencies = 0;
+	// ranges inside the dependency tables, see GetDependencies and GetDependents
+	int32 firstDependency = 0;
+	int32 dependencyCount = 0;
+	int32 firstDependent = 0;
+	int32 dependentCount = 0;
+
+	// windowed counters only, index inside FAchievementWindowedCounters
+	FAchievementWindowSettings window;
+	int32 windowIndex = INDEX_NONE;
+
+	// NAME_None for achievements that are always available, see FAchievementSetSchedule
+	FName achievementSet;
+
+	bool IsComposite() const
+	{
+		return requiredDependencies > 0;
+	}
+};
+
+// runtime copy of a stat's settings
+struct ACHIEVEMENTPLUGIN_API FAchievementStatRegistryEntry
+{
+	FName statId;
+	EAchievementStatType type = EAchievementStatType::Int;
+	FAchievementStatPlatformData platformData;
+
+	// index of this stat's value inside the FAchievementStatStore
+	int32 valueIndex = INDEX_NONE;
+
+	// range inside the watcher table, see GetStatWatchers
+	int32 firstWatcher = 0;
+	int32 watcherCount = 0;
+};
+
+// dense table of all achievements, built once from the settings so that FAchievementHandles can index straight into it
+class ACHIEVEMENTPLUGIN_API FAchievementRegistry
+{
+public:
+	// (re)builds the tables, any handles given out before this will point to the new order
+	void Build(const TMap<FString, FAchievementData>& achievementsData, const TMap<FString, FAchievementStatData>& statsData);
+	void Empty();
+
+	// points every entry at its progress inside the store, adding empty progress where there was none
+	// returns how many progress entries had to be added
+	int32 BindProgress(FAchievementProgressStore& store);
+	// same as BindProgress but for the stat values
+	int32 BindStats(FAchievementStatStore& store);
+
+	// every achievement keeps its slot (and handle), the ones whose bit is cleared are taken out of the lookups below
+	// so they can't be resolved until their set is active again, and their platform data is dropped until then
+	// achievementsData has to be the data the registry was built from, it's where the platform data comes back from
+	void SetLiveAchievements(const TBitArray<>& isLive, const TMap<FString, FAchievementData>& achievementsData);
+	// false for achievements of an inactive set, see FAchievementSetSchedule
+	bool IsLive(const FAchievementHandle handle) const
+	{
+		return m_isLive[handle.GetIndex()];
+	}
+
+	// returns an invalid handle if the achievement does not exist or isn't live
+	// FNames compare by index, so this is an integer hash instead of hashing the whole string
+	FAchievementHandle FindHandle(const FName achievementId) const;
+	// only looks the string up in the name table, prefer the FName version on hot paths
+	FAchievementHandle FindHandle(const FString& achievementId) const;
+	// no hashing, LinkIDs index straight into a table (used by the generated AchievementIds.h)
+	FAchievementHandle FindHandleByLinkID(const int32 linkID) const
+	{
+		return m_handleIndexByLinkID.IsValidIndex(linkID) ? FAchievementHandle(m_handleIndexByLinkID[linkID]) : FAchievementHandle();
+	}
+
+	bool IsValidHandle(const FAchievementHandle handle) const
+	{
+		return m_entries.IsValidIndex(handle.GetIndex());
+	}
+	// only call this with handles that passed IsValidHandle
+	const FAchievementRegistryEntry& GetEntry(const FAchievementHandle handle) const
+	{
+		return m_entries[handle.GetIndex()];
+	}
+
+	int32 Num() const
+	{
+		return m_entries.Num();
+	}
+
+	// the achievements a composite depends on
+	TConstArrayView<int32> GetDependencies(const FAchievementHandle handle) const
+	{
+		const FAchievementRegistryEntry& entry = m_entries[handle.GetIndex()];
+		return TConstArrayView<int32>(m_dependencies.GetData() + entry.firstDependency, entry.dependencyCount);
+	}
+	// the composites that depend on this achievement, the only ones that have to be re-evaluated when it unlocks
+	TConstArrayView<int32> GetDependents(const FAchievementHandle handle) const
+	{
+		const FAchievementRegistryEntry& entry = m_entries[handle.GetIndex()];
+		return TConstArrayView<int32>(m_dependents.GetData() + entry.firstDependent, entry.dependentCount);
+	}
+	// every composite, ordered so that composites come after everything they depend on
+	TConstArrayView<int32> GetCompositeOrder() const
+	{
+		return m_compositeOrder;
+	}
+
+	// returns an invalid handle if the stat does not exist
+	FAchievementStatHandle FindStatHandle(const FName statId) const;
+	bool IsValidStatHandle(const FAchievementStatHandle handle) const
+	{
+		return m_stats.IsValidIndex(handle.GetIndex());
+	}
+	// only call this with handles that passed IsValidStatHandle
+	const FAchievementStatRegistryEntry& GetStatEntry(const FAchievementStatHandle handle) const
+	{
+		return m_stats[handle.GetIndex()];
+	}
+	// registry indices of every achievement watching the stat, precomputed so a stat update never searches
+	// sorted by progressGoal (lowest first), so a cursor can point at the next threshold to cross
+	TConstArrayView<int32> GetStatWatchers(const FAchievementStatHandle handle) const
+	{
+		const FAchievementStatRegistryEntry& stat = m_stats[handle.GetIndex()];
+		return TConstArrayView<int32>(m_statWatchers.GetData() + stat.firstWatcher, stat.watcherCount);
+	}
+	// the progressGoal of every watcher above, in the same order
+	TConstArrayView<int32> GetStatWatcherGoals(const FAchievementStatHandle handle) const
+	{
+		const FAchievementStatRegistryEntry& stat = m_stats[handle.GetIndex()];
+		return TConstArrayView<int32>(m_statWatcherGoals.GetData() + stat.firstWatcher, stat.watcherCount);
+	}
+	int32 NumStats() const
+	{
+		return m_stats.Num();
+	}
+
+	int32 NumWindows() const
+	{
+		return m_windowedAchievements.Num();
+	}
+	// registry indices of the windowed achievements, in window index order
+	TConstArrayView<int32> GetWindowedAchievements() const
+	{
+		return m_windowedAchievements;
+	}
+
+private:
+	// resolves the dependency rules into a DAG, composites that are part of a cycle get their rules dropped
+	void BuildDependencyGraph(TConstArrayView<const FAchievementData*> sourceData);
+
+	TArray<FAchievementRegistryEntry> m_entries;
+	// every achievement is live after Build, SetLiveAchievements clears the ones of inactive sets
+	TBitArray<> m_isLive;
+	// built from the settings' string keys once, the editor keeps authoring with the string map
+	TMap<FName, int32> m_indexByAchievementId;
+	// LinkIDs are small increasing numbers, so a flat table is cheaper than a map
+	TArray<int32> m_handleIndexByLinkID;
+
+	TArray<FAchievementStatRegistryEntry> m_stats;
+	TMap<FName, int32> m_statIndexByStatId;
+	// achievement indices grouped per stat, every stat owns one contiguous range
+	TArray<int32> m_statWatchers;
+	// goals next to each other so crossing checks don't have to touch the entries
+	TArray<int32> m_statWatcherGoals;
+
+	// both directions of the dependency graph, every achievement owns one contiguous range in each
+	TArray<int32> m_dependencies;
+	TArray<int32> m_dependents;
+	TArray<int32> m_compositeOrder;
+
+	TArray<int32> m_windowedAchievements;
+};
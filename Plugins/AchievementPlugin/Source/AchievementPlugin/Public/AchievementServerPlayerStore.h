@@ -0,0 +1,81 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/OnlineReplStructs.h"
+#include "HAL/CriticalSection.h"
+#include "AchievementLocalUserProgress.h"
+
+class FAchievementRegistry;
+class FAchievementProgressStore;
+
+// authoritative per-player progress for dedicated servers, keyed by unique net ID
+// players are spread over NumShards shards by the hash of their ID, every shard has its own lock and its own contiguous rows
+// so threads updating different players rarely wait on each other, and memory and work grow linearly with the player count
+class ACHIEVEMENTPLUGIN_API FAchievementServerPlayerStore
+{
+public:
+	static constexpr int32 NumShards = 16;
+
+	// (re)sizes every row to the registry's live achievements and keeps the progress by LinkID
+	// Note: game thread only, when the registry itself was rebuilt nothing else may use the store while it is being built
+	// when only the live achievements changed (a set started or ended) the updates below can keep running meanwhile
+	void Build(const FAchievementRegistry& registry);
+	void Empty();
+
+	// everything below is thread-safe, as long as the registry isn't rebuilt meanwhile
+	// every shard keeps the live achievements of its last Build, so sets starting or ending don't race with the updates
+	// returns false if the player already has a row
+	bool AddPlayer(const FUniqueNetIdRepl& playerId);
+	bool RemovePlayer(const FUniqueNetIdRepl& playerId);
+	bool HasPlayer(const FUniqueNetIdRepl& playerId) const;
+	// whether the player's save was merged in, until then exporting the row for a save would overwrite the slot
+	bool IsPlayerLoaded(const FUniqueNetIdRepl& playerId) const;
+	int32 NumPlayers() const;
+
+	// the handle has to be valid, returns false (and logs) if the achievement isn't live or the player has no row
+	bool IncreaseProgress(const FUniqueNetIdRepl& playerId, FAchievementHandle handle, float increase);
+	// the same change for every player, every shard is only locked once, returns how many players got it
+	int32 IncreaseProgressForPlayers(TConstArrayView<FUniqueNetIdRepl> playerIds, FAchievementHandle handle, float increase);
+	// returns false if the player has no row
+	bool GetProgress(const FUniqueNetIdRepl& playerId, FAchievementHandle handle, FAchievementProgress& outProgress) const;
+
+	// conversions by LinkID for the save files, return false if the player has no row
+	bool ExportPlayer(const FUniqueNetIdRepl& playerId, FAchievementProgressStore& outStore) const;
+	// keeps the highest progress of both, the player could already have made progress while the save was loading
+	// the player counts as loaded afterwards
+	bool MergePlayer(const FUniqueNetIdRepl& playerId, const FAchievementProgressStore& store);
+
+	// loaded players whose progress changed since they were last collected, their dirty flags get cleared
+	// players still waiting for their save stay dirty until they are loaded
+	void CollectDirtyPlayers(TArray<FUniqueNetIdRepl>& outPlayerIds);
+	// unlocks since the last call, in order per shard
+	void CollectUnlocks(TArray<TPair<FUniqueNetIdRepl, FAchievementHandle>>& outUnlocks);
+
+private:
+	struct FShard
+	{
+		mutable FCriticalSection lock;
+		// server rows are found through rowByPlayer, the local user index of every row is unused
+		FAchievementLocalUserProgress progress;
+		TArray<FUniqueNetIdRepl> playerIds;
+		TMap<FUniqueNetIdRepl, int32> rowByPlayer;
+		TBitArray<> dirtyRows;
+		// set once the row's save got merged in
+		TBitArray<> loadedRows;
+		TArray<TPair<FUniqueNetIdRepl, FAchievementHandle>> unlocks;
+		// reused for every increase, so unlocking doesn't allocate
+		TArray<int32> unlockedScratch;
+	};
+
+	static int32 GetShardIndex(const FUniqueNetIdRepl& playerId)
+	{
+		return GetTypeHash(playerId) & (NumShards - 1);
+	}
+	void LogInactive(FAchievementHandle handle) const;
+	// the shard has to be locked, and the achievement live in it
+	void IncreaseRowProgress(FShard& shard, int32 row, FAchievementHandle handle, float increase) const;
+
+	FShard m_shards[NumShards];
+	// set by Build, the subsystem owns the registry
+	const FAchievementRegistry* m_registry = nullptr;
+};
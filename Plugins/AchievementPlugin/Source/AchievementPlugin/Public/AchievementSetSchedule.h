@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAchievementRegistry;
+struct FAchievementSetData;
+
+// which achievement sets are active right now, and when that changes next
+// the registry always holds every achievement so handles stay stable, a live bit per registry index keeps
+// the achievements of inactive sets out of the active set, the tag bindings and everything else that gets evaluated
+// Note: their progress stays in the stores by LinkID, so it's saved and back once the set returns
+// the other users' rows only keep it where there is any, see FAchievementLocalUserProgress
+class ACHIEVEMENTPLUGIN_API FAchievementSetSchedule
+{
+public:
+	// evaluates every set at nowUtc and remembers the closest start or end after it
+	void Build(const TMap<FString, FAchievementSetData>& achievementSets, const FDateTime& nowUtc);
+	void Empty();
+
+	bool IsSetActive(const FName setId) const
+	{
+		return m_activeSets.Contains(setId);
+	}
+	int32 NumActiveSets() const
+	{
+		return m_activeSets.Num();
+	}
+
+	// false if no set starts or ends in the future, then there's no need to look at the clock
+	bool HasScheduledChange() const
+	{
+		return m_nextChangeUtc != FDateTime::MaxValue();
+	}
+	// a set started or ended since Build, the live bits have to be updated
+	bool IsChangeDue(const FDateTime& nowUtc) const
+	{
+		return nowUtc >= m_nextChangeUtc;
+	}
+
+	// one bit per registry index, set for achievements without a set or in an active set, returns how many are not live
+	// achievements in a set that doesn't exist stay live (with a warning) so a typo doesn't hide them
+	int32 BuildLiveBits(const FAchievementRegistry& registry, TBitArray<>& outIsLive) const;
+
+private:
+	TSet<FName> m_activeSets;
+	TSet<FName> m_knownSets;
+	FDateTime m_nextChangeUtc = FDateTime::MaxValue();
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// structure-of-arrays storage for all stat values, keyed by stat name (stats have no LinkID)
+// Note: just like the progress store, indices only change when entries get removed (RemoveAll/Empty)
+class ACHIEVEMENTPLUGIN_API FAchievementStatStore
+{
+public:
+	int32 Num() const
+	{
+		return m_statIds.Num();
+	}
+	bool IsValidIndex(const int32 index) const
+	{
+		return m_statIds.IsValidIndex(index);
+	}
+
+	// returns INDEX_NONE if there is no value for the stat
+	int32 FindIndex(const FName statId) const
+	{
+		const int32* index = m_indexByStatId.Find(statId);
+		return index ? *index : INDEX_NONE;
+	}
+	// returns the index for the stat, adding a zeroed value if it did not exist yet
+	int32 FindOrAdd(FName statId, bool* bOutWasAdded = nullptr);
+
+	FName GetStatId(const int32 index) const
+	{
+		return m_statIds[index];
+	}
+	// the total for Int and Float stats, the summed count for AverageRate stats
+	double GetValue(const int32 index) const
+	{
+		return m_values[index];
+	}
+	// summed seconds, only used by AverageRate stats
+	double GetDuration(const int32 index) const
+	{
+		return m_durations[index];
+	}
+
+	TConstArrayView<FName> GetStatIds() const
+	{
+		return m_statIds;
+	}
+	TConstArrayView<double> GetValues() const
+	{
+		return m_values;
+	}
+	TConstArrayView<double> GetDurations() const
+	{
+		return m_durations;
+	}
+
+	void SetValue(const int32 index, const double value)
+	{
+		m_values[index] = value;
+	}
+	void SetDuration(const int32 index, const double duration)
+	{
+		m_durations[index] = duration;
+	}
+	void Reset(int32 index);
+	void Empty();
+
+	// removes every entry the predicate returns true for and compacts the columns, returns the amount removed
+	int32 RemoveAll(TFunctionRef<bool(FName statId)> predicate);
+
+private:
+	TArray<FName> m_statIds;
+	TArray<double> m_values;
+	TArray<double> m_durations;
+
+	TMap<FName, int32> m_indexByStatId;
+};
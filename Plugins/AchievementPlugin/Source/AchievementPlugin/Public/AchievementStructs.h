@@ -2,10 +2,44 @@
 
 #include "CoreMinimal.h"
 #include "Engine/Texture2D.h"
+#include "GameplayTagContainer.h"
 #include "AchievementPlatformsEnum.h"
 
 #include "AchievementStructs.generated.h" 
 
+UENUM(BlueprintType)
+// how a progress change gets applied
+enum class EAchievementUpdateMode : uint8
+{
+	// applied, checked for unlocking and sent to the platform right away
+	Immediate = 0,
+	// summed with every other change to the same achievement this frame, applied and uploaded once at the end of the frame
+	Accumulate
+};
+
+UENUM(BlueprintType)
+// how a stat's value gets tracked, mirrors the stat types platforms like Steam support
+enum class EAchievementStatType : uint8
+{
+	// whole numbers, increases get rounded
+	Int = 0,
+	Float,
+	// count per second over all sessions (kills per hour, ...), updated with Add Average Rate Sample
+	AverageRate
+};
+
+UENUM(BlueprintType)
+// how long progress lives before ResetAchievementScope clears it again
+enum class EAchievementScope : uint8
+{
+	// never reset
+	Persistent = 0,
+	Session,
+	Match,
+	// "in one life"
+	Life
+};
+
 // this will allow the achievement structs to be "linked", only inherited by the data version
 USTRUCT(BlueprintType)
 struct FLinkedStruct
@@ -32,20 +66,125 @@ private:
 };
 
 
+USTRUCT(BlueprintType)
+// a resolved achievement, get one once with GetAchievementHandle and use it to update progress without any string lookups
+struct ACHIEVEMENTPLUGIN_API FAchievementHandle
+{
+	GENERATED_BODY()
+public:
+	FAchievementHandle() = default;
+	explicit FAchievementHandle(const int32 index)
+	{
+		m_index = index;
+	}
+
+	bool IsValid() const
+	{
+		return m_index != INDEX_NONE;
+	}
+	// the dense index inside the achievement registry
+	int32 GetIndex() const
+	{
+		return m_index;
+	}
+
+	bool operator==(const FAchievementHandle& other) const
+	{
+		return m_index == other.m_index;
+	}
+	friend uint32 GetTypeHash(const FAchievementHandle& handle)
+	{
+		return GetTypeHash(handle.m_index);
+	}
+private:
+	UPROPERTY()
+	int32 m_index = INDEX_NONE;
+};
+
+USTRUCT(BlueprintType)
+// a resolved stat, get one once with GetStatHandle and use it for every following update
+struct ACHIEVEMENTPLUGIN_API FAchievementStatHandle
+{
+	GENERATED_BODY()
+public:
+	FAchievementStatHandle() = default;
+	explicit FAchievementStatHandle(const int32 index)
+	{
+		m_index = index;
+	}
+
+	bool IsValid() const
+	{
+		return m_index != INDEX_NONE;
+	}
+	// the dense index inside the registry's stat table
+	int32 GetIndex() const
+	{
+		return m_index;
+	}
+
+	bool operator==(const FAchievementStatHandle& other) const
+	{
+		return m_index == other.m_index;
+	}
+	friend uint32 GetTypeHash(const FAchievementStatHandle& handle)
+	{
+		return GetTypeHash(handle.m_index);
+	}
+private:
+	UPROPERTY()
+	int32 m_index = INDEX_NONE;
+};
+
+USTRUCT(BlueprintType)
+// a single entry for the batched progress functions, the handle is used when valid, otherwise the ID gets resolved
+struct ACHIEVEMENTPLUGIN_API FAchievementProgressChange
+{
+	GENERATED_BODY()
+public:
+	FAchievementProgressChange() = default;
+	FAchievementProgressChange(const FAchievementHandle inHandle, const float inChange)
+		: handle(inHandle), change(inChange)
+	{}
+	FAchievementProgressChange(const FName inAchievementId, const float inChange)
+		: achievementId(inAchievementId), change(inChange)
+	{}
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Achievements")
+	FAchievementHandle handle;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Achievements")
+	FName achievementId;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Achievements")
+	float change = 0.f;
+};
+
 USTRUCT(BlueprintType)
 // this struct has all the data that can be changed during runtime, ReadWrite for blueprints
 struct ACHIEVEMENTPLUGIN_API FAchievementProgress
 {
 	GENERATED_BODY()
 public:
+	// unlock time used for achievements that have never been unlocked
+	static constexpr int64 NeverUnlockedTicks = 0;
+
 	FAchievementProgress() = default;
 
+	FDateTime GetUnlockedTimeUtc() const
+	{
+		return FDateTime(unlockedTicks);
+	}
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"), SaveGame)
 	float progress = 0;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame)
 	bool bIsAchievementUnlocked = false;
+	// UTC ticks (FDateTime), NeverUnlockedTicks if it was never unlocked. Use "Format Achievement Unlock Time" for UI
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, SaveGame)
-	FString unlockedTime = "Never";
+	int64 unlockedTicks = NeverUnlockedTicks;
+
+	// only kept so old saves (which stored the formatted local time) can be migrated
+	UPROPERTY(SaveGame, meta = (DeprecatedProperty))
+	FString unlockedTime_DEPRECATED;
 };
 
 USTRUCT(BlueprintType)
@@ -69,6 +208,99 @@ public:
 	FString epicID = "";
 };
 
+USTRUCT(BlueprintType)
+struct ACHIEVEMENTPLUGIN_API FAchievementStatPlatformData
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Steam",
+			  meta = (DisplayName = "Steam Stat ID"))
+	FString steamStatID = "";
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Epic",
+			  meta = (DisplayName = "Epic Stat ID"))
+	FString epicStatID = "";
+};
+
+USTRUCT(BlueprintType)
+// a gameplay stat inside the developer settings, achievements can watch one instead of tracking their own progress
+struct ACHIEVEMENTPLUGIN_API FAchievementStatData
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Stat")
+	EAchievementStatType type = EAchievementStatType::Int;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Platforms",
+			  meta = (DisplayName = "Platform Data"))
+	FAchievementStatPlatformData platformData;
+};
+
+USTRUCT(BlueprintType)
+// makes an achievement a meta-achievement that unlocks through other achievements ("unlock all combat achievements", "3 of these 5")
+struct ACHIEVEMENTPLUGIN_API FAchievementDependencyRule
+{
+	GENERATED_BODY()
+public:
+	bool IsSet() const
+	{
+		return requiredAchievements.Num() > 0;
+	}
+
+	// names of the achievements this one depends on (keys of AchievementsData)
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Composite")
+	TArray<FName> requiredAchievements;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Composite", meta = (ClampMin = "0",
+			  ToolTip = "How many of the required achievements have to be unlocked, 0 means all of them"))
+	int32 requiredCount = 0;
+};
+
+USTRUCT(BlueprintType)
+// turns an achievement into a windowed counter: "5 kills within 10 seconds", "travel 500 feet in one life"
+struct ACHIEVEMENTPLUGIN_API FAchievementWindowSettings
+{
+	GENERATED_BODY()
+public:
+	bool IsSet() const
+	{
+		return windowSeconds > 0.f || resetScope != EAchievementScope::Persistent;
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Window", meta = (ClampMin = "0", Units = "Seconds",
+			  ToolTip = "Only progress made within this many seconds counts, 0 keeps it until the scope resets"))
+	float windowSeconds = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Window", meta = (ClampMin = "1", ClampMax = "64",
+			  ToolTip = "The window is split into this many slots, progress expires one slot at a time. More slots are more precise but use more memory"))
+	int32 bucketCount = 16;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Window",
+			  meta = (ToolTip = "Which Reset Achievement Scope call clears the counted progress"))
+	EAchievementScope resetScope = EAchievementScope::Persistent;
+};
+
+USTRUCT(BlueprintType)
+// a batch of achievements (a live-ops season or event) that only exists at runtime between its start and end
+struct ACHIEVEMENTPLUGIN_API FAchievementSetData
+{
+	GENERATED_BODY()
+public:
+	// an unset (zero) start or end leaves that side open
+	bool IsActiveAt(const FDateTime& nowUtc) const
+	{
+		return (startTimeUtc.GetTicks() == 0 || nowUtc >= startTimeUtc) && (endTimeUtc.GetTicks() == 0 || nowUtc < endTimeUtc);
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Set", meta = (DisplayName = "Start Time (UTC)",
+			  ToolTip = "The set's achievements become available at this time, leave it unset to start right away"))
+	FDateTime startTimeUtc;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Set", meta = (DisplayName = "End Time (UTC)",
+			  ToolTip = "The set's achievements stop being evaluated at this time (their progress stays saved), leave it unset to never end"))
+	FDateTime endTimeUtc;
+};
+
 USTRUCT(BlueprintType)
 // this struct has all the data that is inside the developer settings, ReadOnly for blueprints
 struct ACHIEVEMENTPLUGIN_API FAchievementData : public FLinkedStruct
@@ -95,6 +327,34 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (ClampMin = "0"))
 	int32 progressGoal = 1;
 
+	// when set, the progress is the stat's value and the achievement unlocks once the stat reaches progressGoal
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (DisplayName = "Watched Stat",
+			  ToolTip = "Name of a stat in StatsData. Leave empty to track progress on the achievement itself"))
+	FName watchedStat;
+
+	// when set, the progress is the amount of unlocked required achievements and progressGoal is ignored
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (DisplayName = "Dependencies"))
+	FAchievementDependencyRule dependencies;
+
+	// when set, the progress only counts what happened inside the window/scope and is not kept between sessions
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (DisplayName = "Window"))
+	FAchievementWindowSettings window;
+
+	// when set, every ReportGameplayEvent with a tag matching the query adds its magnitude to the progress
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (DisplayName = "Gameplay Event Query",
+			  ToolTip = "Gameplay events (Report Gameplay Event) whose tag matches this query count towards the achievement"))
+	FGameplayTagQuery eventQuery;
+
+	// when set, the achievement unlocks as soon as the condition over the stats holds, its own progress can't be changed
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (DisplayName = "Unlock Condition",
+			  ToolTip = "For example: wins >= 10 && deaths == 0 && difficulty >= 2. Names are stats from StatsData, supports && || ! (or AND OR NOT), comparisons, + - * / and parentheses"))
+	FString unlockCondition;
+
+	// when set, the achievement only exists while the set is active, see AchievementSets
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Public", meta = (DisplayName = "Achievement Set",
+			  ToolTip = "Name of a set in AchievementSets. Leave empty for an achievement that is always available"))
+	FName achievementSet;
+
 	// Platform-specific identifiers
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Platforms",
 			  meta = (DisplayName = "Platform Data"))
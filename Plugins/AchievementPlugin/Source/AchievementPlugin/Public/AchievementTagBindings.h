@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+class FAchievementRegistry;
+class FAchievementConditions;
+struct FAchievementData;
+
+// which achievements a gameplay event tag counts towards, compiled from every achievement's eventQuery
+// every tag gets one contiguous range of registry indices, so reporting an event is a single map lookup
+// Note: game thread only, tags no query mentions are evaluated (and cached) the first time they get reported
+class ACHIEVEMENTPLUGIN_API FAchievementTagBindings
+{
+public:
+	// precomputes the ranges for every tag the queries mention, including their child tags
+	// achievements without their own progress (stat, dependencies, unlock condition) are never bound, so build the conditions first
+	// neither are the ones the registry can't find (inactive sets), rebuild the bindings when a set starts or ends
+	void Build(const FAchievementRegistry& registry, const FAchievementConditions& conditions, const TMap<FString, FAchievementData>& achievementsData);
+	void Empty();
+
+	// registry indices of every achievement whose query matches the tag
+	TConstArrayView<int32> Find(FGameplayTag tag);
+
+	int32 NumBoundAchievements() const
+	{
+		return m_queries.Num();
+	}
+
+private:
+	// evaluates every query against the tag (and its parents) and stores the matches as the tag's range
+	TConstArrayView<int32> Compile(FGameplayTag tag);
+
+	// registry index and query of every achievement listening to events
+	TArray<TPair<int32, FGameplayTagQuery>> m_queries;
+
+	// start and count inside m_boundAchievements per tag
+	TMap<FGameplayTag, TPair<int32, int32>> m_rangeByTag;
+	TArray<int32> m_boundAchievements;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementStructs.h"
+
+class UAchievementManagerSubSystem;
+
+// a stat change inside a transaction, increases and sets of the same stat are folded into one
+struct ACHIEVEMENTPLUGIN_API FAchievementTransactionStatChange
+{
+	FAchievementStatHandle handle;
+	double value = 0.0;
+	// whether value replaces the stat or gets added to it
+	bool bIsSet = false;
+};
+
+// collects the progress and stat changes of one gameplay event (finishing a level, ...) and applies them together
+// Commit evaluates every touched achievement and stat once, flushes the platform once and marks the save dirty once
+// nothing is applied before Commit, Abort or letting the transaction go out of scope discards everything
+// Note: game thread only, handles are checked when the change is added and again on Commit (which applies nothing if one became invalid)
+class ACHIEVEMENTPLUGIN_API FAchievementTransaction
+{
+public:
+	FAchievementTransaction();
+	explicit FAchievementTransaction(UAchievementManagerSubSystem* manager);
+	~FAchievementTransaction();
+
+	FAchievementTransaction(const FAchievementTransaction&) = delete;
+	FAchievementTransaction& operator=(const FAchievementTransaction&) = delete;
+
+	// return false (and keep nothing) if the change can't be applied, the other changes are not affected
+	bool IncreaseProgress(FAchievementHandle handle, float increase);
+	bool IncreaseStat(FAchievementStatHandle handle, double increase);
+	bool SetStat(FAchievementStatHandle handle, double value);
+
+	// returns how many achievements and stats were changed, the transaction is closed afterwards
+	int32 Commit();
+	void Abort();
+
+	bool IsOpen() const
+	{
+		return m_bIsOpen;
+	}
+
+private:
+	bool CanChangeStat(FAchievementStatHandle handle) const;
+	FAchievementTransactionStatChange& FindOrAddStatChange(FAchievementStatHandle handle);
+
+	TWeakObjectPtr<UAchievementManagerSubSystem> m_manager;
+	// one entry per achievement and per stat
+	TArray<FAchievementProgressChange> m_progressChanges;
+	TArray<FAchievementTransactionStatChange> m_statChanges;
+	bool m_bIsOpen = true;
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AchievementStructs.h"
+
+class FAchievementRegistry;
+
+// ring buffers for windowed achievements, every window owns a fixed range of buckets inside one pool
+// adding is O(1) amortised: every bucket expires at most once per lap around its ring
+// resetting a scope is O(1) as well, it bumps the scope's generation and every window clears itself the next time it is used
+// Note: game thread only, windows are indexed by FAchievementRegistryEntry::windowIndex
+class ACHIEVEMENTPLUGIN_API FAchievementWindowedCounters
+{
+public:
+	// (re)creates every window for the registry, all counted progress is cleared
+	void Build(const FAchievementRegistry& registry);
+
+	// adds to the window and returns what is counted inside it afterwards
+	float Add(int32 windowIndex, float amount, double currentTime);
+	// expires old buckets without adding, returns what is counted inside the window afterwards
+	float Advance(int32 windowIndex, double currentTime);
+	float GetTotal(const int32 windowIndex) const
+	{
+		const FWindow& window = m_windows[windowIndex];
+		return IsStale(window) ? 0.f : window.total;
+	}
+
+	// clears every window that resets with the scope, Persistent windows are never reset
+	void ResetScope(EAchievementScope scope);
+	void Reset(int32 windowIndex);
+
+	// changes every time the scope is reset, also lets game code tell whether a scope ended since it last looked
+	uint32 GetScopeGeneration(const EAchievementScope scope) const
+	{
+		return m_scopeGenerations[static_cast<int32>(scope)];
+	}
+
+	int32 Num() const
+	{
+		return m_windows.Num();
+	}
+	EAchievementScope GetScope(const int32 windowIndex) const
+	{
+		return m_windows[windowIndex].scope;
+	}
+
+private:
+	static constexpr int32 NumScopes = static_cast<int32>(EAchievementScope::Life) + 1;
+
+	struct FWindow
+	{
+		int32 firstBucket = 0;
+		int32 bucketCount = 1;
+		// 0 for windows that only reset with their scope, they never expire
+		double bucketSeconds = 0.0;
+		int32 headBucket = 0;
+		double headStartTime = 0.0;
+		float total = 0.f;
+		EAchievementScope scope = EAchievementScope::Persistent;
+		// the scope generation the buckets were counted in
+		uint32 generation = 0;
+	};
+
+	bool IsStale(const FWindow& window) const
+	{
+		return window.generation != m_scopeGenerations[static_cast<int32>(window.scope)];
+	}
+	// clears the window if its scope was reset since it was last used
+	void ClearIfStale(int32 windowIndex, double currentTime);
+
+	TArray<FWindow> m_windows;
+	TArray<float> m_buckets;
+	uint32 m_scopeGenerations[NumScopes] = {};
+};
@@ -12,7 +12,11 @@ public:
 	static void Tick();
 	static TMap<FString, FAchievementData> GetSteamAchievementsAsAchievementDataMap();
 
-	static bool SetSteamAchievementProgress(const FAchievementPlatformData& achievementData, float progress, bool unlocked);
+	static bool SetSteamAchievementProgress(const FAchievementPlatformData& achievementData, float progress, bool unlocked, bool bStoreImmediately = true);
+	static bool SetSteamStat(const FAchievementStatPlatformData& statData, EAchievementStatType type, double value, bool bStoreImmediately = true);
+	static bool UpdateSteamAverageRateStat(const FAchievementStatPlatformData& statData, double count, double seconds, bool bStoreImmediately = true);
+	// uploads everything set since the last call in a single StoreStats
+	static bool StoreSteamStats();
 	static bool DeleteSteamAchievementProgress(const FAchievementPlatformData& achievementData);
 	static bool DeleteAllSteamAchievementProgress();
 
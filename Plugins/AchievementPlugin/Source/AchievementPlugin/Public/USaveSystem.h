@@ -1,7 +1,10 @@
 #pragma once
 
 #include "AchievementStructs.h"
+#include "AchievementProgressStore.h"
+#include "AchievementStatStore.h"
 #include "GameFramework/SaveGame.h"
+#include "GameFramework/OnlineReplStructs.h"
 
 #include "USaveSystem.generated.h"
 
@@ -12,15 +15,49 @@ class ACHIEVEMENTPLUGIN_API UAchievementSave : public USaveGame
 	GENERATED_BODY()
 
 public:
-	// Constructor that takes reference to avoid copying
-	void SetData(const TMap<int32, FAchievementProgress>& inData)
-	{
-		achievementProgressSave = inData;
-	}
+	// 0 is used by saves from before the version existed (those only have achievementProgressSave)
+	static constexpr int32 LegacySaveVersion = 0;
+	static constexpr int32 CurrentSaveVersion = 1;
+
+	// snapshots the store by copying its columns
+	void SetData(const FAchievementProgressStore& inData);
+	// fills the store, migrating legacy saves if needed
+	void GetData(FAchievementProgressStore& outData) const;
+
+	void SetStats(const FAchievementStatStore& inStats);
+	// saves from before stats existed simply have no stat columns
+	void GetStats(FAchievementStatStore& outStats) const;
+
+	UPROPERTY(SaveGame)
+	int32 saveVersion = LegacySaveVersion;
+
+	// progress columns, every index belongs to the same LinkID
+	UPROPERTY(SaveGame)
+	TArray<int32> linkIDs;
+	UPROPERTY(SaveGame)
+	TArray<float> progress;
+	UPROPERTY(SaveGame)
+	TArray<bool> unlocked;
+	// UTC ticks, FAchievementProgress::NeverUnlockedTicks if it was never unlocked
+	UPROPERTY(SaveGame)
+	TArray<int64> unlockedTicks;
+
+	// stat columns, every index belongs to the same stat
+	UPROPERTY(SaveGame)
+	TArray<FName> statIds;
+	UPROPERTY(SaveGame)
+	TArray<double> statValues;
+	UPROPERTY(SaveGame)
+	TArray<double> statDurations;
+
+	// legacy format, only read when migrating old saves
 	UPROPERTY(SaveGame)
 	TMap<int32, FAchievementProgress> achievementProgressSave;
 };
 
+// the loaded progress is empty if the player had no save yet
+DECLARE_DELEGATE_TwoParams(FOnPlayerProgressLoaded, const FUniqueNetIdRepl& /*playerId*/, const FAchievementProgressStore& /*progress*/);
+
 // note: this class only exists in UAchievementManagerSubSystem (by default)
 UCLASS(BlueprintType, Blueprintable)
 class ACHIEVEMENTPLUGIN_API UAchievementSaveManager : public UObject
@@ -33,19 +70,33 @@ public:
 	}
 
 	// returns whether the save was successful
-	bool SaveProgressAsync(const TMap<int32, FAchievementProgress>& achievements);
+	bool SaveProgressAsync(const FAchievementProgressStore& achievements, const FAchievementStatStore& stats);
 
 	// returns whether the save was successful
 	// Note: For saves during runtime, use SaveProgressAsync instead!
-	bool SaveProgress(const TMap<int32, FAchievementProgress>& achievements) const;
+	bool SaveProgress(const FAchievementProgressStore& achievements, const FAchievementStatStore& stats) const;
+
+	// fills outAchievements and outStats with the loaded progress, empties them if there was no save
+	// returns whether a save was loaded
+	bool LoadProgress(FAchievementProgressStore& outAchievements, FAchievementStatStore& outStats) const;
+
+	// additional local (split-screen) users get their own slot next to the primary one, they have no stats
+	bool SaveLocalUserProgress(const FAchievementProgressStore& achievements, int32 localUserIndex) const;
+	bool LoadLocalUserProgress(FAchievementProgressStore& outAchievements, int32 localUserIndex) const;
 
-	// returns the loaded achievementsData' progress
-	TMap<int32, FAchievementProgress> LoadProgress() const;
+	// dedicated servers: one slot per connected player, named after its unique net ID
+	// unlike SaveProgressAsync, saves for different players can run at the same time
+	bool SavePlayerProgressAsync(const FAchievementProgressStore& achievements, const FUniqueNetIdRepl& playerId);
+	bool SavePlayerProgress(const FAchievementProgressStore& achievements, const FUniqueNetIdRepl& playerId) const;
+	// onLoaded is called on the game thread once the load finished
+	void LoadPlayerProgressAsync(const FUniqueNetIdRepl& playerId, FOnPlayerProgressLoaded onLoaded);
 
 	void SetSaveSlotSettings(const FSaveSlotSettings& newSettings);
 	void SetSaveSlotIndex(const int32 newIndex);
 
 private:
+	FString GetLocalUserSlotName(int32 localUserIndex) const;
+	FString GetPlayerSlotName(const FUniqueNetIdRepl& playerId) const;
 	void OnAsyncSaveComplete(const FString& slotName, const int32 userIndex, bool bSuccess);
 
 	bool m_bIsSaving = false;